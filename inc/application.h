@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -26,15 +27,19 @@ protected:
     std::vector<ControllerBase *> _controller_list; /**< list of controllers */
     SDL_Window *_window = nullptr;                  /**< window to render in */
     SDL_Renderer *_renderer = nullptr;              /**< renderer to render on */
+    SDL_Surface *_surface = nullptr;                /**< offscreen surface in headless mode */
     unsigned _window_width;                         /**< width of window */
     unsigned _window_height;                        /**< height of window */
     unsigned _target_fps = 60;                      /**< number of targeted frames per second */
-    unsigned _current_fps = 0;                      /**< number of frames in the last second */
+    std::atomic<unsigned> _current_fps = 0;         /**< number of frames in the last second */
     unsigned _target_tps = 60;                      /**< number of targeted ticks per second */
-    unsigned _current_tps = 0;                      /**< number of ticks in the last second */
-    unsigned _current_loops = 0;                    /**< number of run loops in the last second */
+    std::atomic<unsigned> _current_tps = 0;         /**< number of ticks in the last second */
+    std::atomic<unsigned> _current_loops = 0;       /**< number of run loops in the last second */
+    std::atomic<unsigned long> _rendered_frames = 0;    /**< number of rendered frames */
+    unsigned long _frame_limit = 0;                 /**< number of frames to quit after. 0 for none */
 
     bool _is_headless = false;
+    bool _is_render_threaded = false;   /**< flag that determines whether ticks run on their own thread */
 
     CommandLine _command_line;
 
@@ -44,6 +49,11 @@ protected:
      */
     static void init_SDL();
 
+    /**
+     * initialise everything concerning SDL without video output
+     */
+    static void init_headless_SDL();
+
     /**
      * initialise the window
      * @param title window title
@@ -60,6 +70,13 @@ protected:
      */
     static SDL_Renderer *init_renderer(SDL_Window *window);
 
+    /**
+     * initialise a software renderer for rendering offscreen
+     * @param surface surface to render on
+     * @return pointer to initialised renderer
+     */
+    static SDL_Renderer *init_software_renderer(SDL_Surface *surface);
+
     /**
      * do further initialisation in derived classes
      */
@@ -71,6 +88,12 @@ protected:
      */
     void deinit() {}
 
+    /**
+     * run the main loop with ticks on an update thread. This thread only pumps events and renders,
+     * so slow ticks do not delay frames and slow frames do not delay ticks.
+     */
+    void run_render_threaded();
+
     /**
      * trigger update on all the existing controllers
      */
@@ -101,7 +124,7 @@ protected:
 public:
 
     /** flag that determines whether this application should continue running */
-    bool _is_running = true;
+    std::atomic<bool> _is_running = true;
 
     /**
      * run application
@@ -121,6 +144,19 @@ public:
      */
     SDL_Renderer *renderer();
 
+    /**
+     * Getter for _surface
+     * This holds the last rendered frame in headless mode.
+     * @return this->_surface. nullptr if not headless.
+     */
+    SDL_Surface *surface();
+
+    /**
+     * Getter for _rendered_frames
+     * @return this->_rendered_frames
+     */
+    unsigned long rendered_frames() const;
+
     /**
      * Getter for _window_width
      * @return this->_window_width
@@ -141,6 +177,13 @@ public:
 
     bool is_headless() const;
 
+    /**
+     * Getter for _is_render_threaded
+     * Views then render snapshots the update thread publishes every tick.
+     * @return this->_is_render_threaded
+     */
+    bool is_render_threaded() const;
+
     CommandLine *command_line();
 
     /**
@@ -19,6 +19,15 @@ namespace SDL_GUI {
  */
 void read_sdl_events();
 
+/**
+ * Poll SDL events into a queue that can be taken from another thread with `take_sdl_events()`.
+ * SDL only allows polling on the thread that created the window.
+ */
+void pump_sdl_events();
+
+/** Put all events queued by `pump_sdl_events()` into the event vector. */
+void take_sdl_events();
+
 /** Clear event vector. */
 void clear_sdl_events();
 
@@ -35,7 +35,7 @@ public:
     /** init controller */
     virtual void init();
 
-    /** change style of hovered drawable */
+    /** apply queued mutations and change style of hovered drawable */
     virtual void update() override;
 };
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+namespace SDL_GUI {
+/** decoded image inside of an asset pack */
+struct AssetPackImage {
+    int _width = 0;                     /**< width of image */
+    int _height = 0;                    /**< height of image */
+    const void *_pixels = nullptr;      /**< tightly packed RGBA32 pixels inside of the mapping */
+};
+
+/**
+ * Read only file of pre-decoded images that gets memory mapped.
+ * Layout (native byte order):
+ *  - header: magic "SGPK", uint32 version, uint32 number of images
+ *  - index per image: uint32 length of name, name, uint32 width, uint32 height, uint64 offset
+ *  - pixel data of each image at its offset, aligned to PIXEL_ALIGNMENT
+ */
+class AssetPack {
+    void *_mapping = nullptr;       /**< start of the mapped file */
+    size_t _size = 0;               /**< size of the mapped file */
+    std::map<std::string, AssetPackImage> _images;  /**< mapping from names to images */
+
+public:
+    /** version of the file format */
+    static const unsigned VERSION = 1;
+
+    /** alignment of pixel data inside of the file */
+    static const unsigned PIXEL_ALIGNMENT = 16;
+
+    /** Default constructor */
+    AssetPack() = default;
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    /** Destructor */
+    ~AssetPack();
+
+    /**
+     * map a pack file. A previously opened pack gets closed.
+     * @param path path to pack file
+     * @return whether the file is a valid pack
+     */
+    bool open(std::string path);
+
+    /** unmap the pack file */
+    void close();
+
+    /**
+     * get an image by name
+     * @param name name of image. This is the path the image got packed from.
+     * @return the image. nullptr if the pack does not contain it.
+     */
+    const AssetPackImage *find(const std::string &name) const;
+
+    /**
+     * get the number of images in the pack
+     * @return number of images
+     */
+    size_t size() const;
+
+    /**
+     * write a pack file
+     * @param path path to pack file
+     * @param images names and images to pack. Images get converted to RGBA32.
+     * @return whether the file got written
+     */
+    static bool write(std::string path,
+                      const std::vector<std::pair<std::string, SDL_Surface *>> &images);
+};
+}
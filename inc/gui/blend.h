@@ -0,0 +1,137 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "rgb.h"
+
+/**
+ * @file
+ * pixel kernels for drawing directly onto ARGB8888 surfaces.
+ *
+ * Every kernel has a scalar implementation and vectorised ones for SSE2, AVX2 and NEON. All of
+ * them use the same integer arithmetic, so their results are identical to the last bit. The
+ * fastest implementation the CPU supports gets selected at runtime.
+ */
+
+namespace SDL_GUI {
+namespace blend {
+/** available implementations of the kernels */
+enum class Implementation {
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON,
+};
+
+/**
+ * get the implementation that is currently used
+ * @return implementation in use
+ */
+Implementation implementation();
+
+/**
+ * select an implementation of the kernels
+ * @param implementation implementation to use
+ * @return true if the CPU supports the implementation and it got selected
+ */
+bool use(Implementation implementation);
+
+/**
+ * get a human readable name of an implementation
+ * @param implementation implementation to get name of
+ * @return name of implementation
+ */
+const char *name(Implementation implementation);
+
+/**
+ * blend a solid color over a row of pixels. The color gets premultiplied once and every pixel
+ * is computed as color + dst * (255 - alpha) / 255.
+ * @param dst pixels to blend onto
+ * @param count number of pixels
+ * @param color ARGB8888 color with straight alpha
+ */
+void fill(Uint32 *dst, int count, Uint32 color);
+
+/**
+ * blend a row of pixels with straight alpha over another row (source over)
+ * @param dst pixels to blend onto
+ * @param src ARGB8888 pixels to blend
+ * @param count number of pixels
+ */
+void blit(Uint32 *dst, const Uint32 *src, int count);
+
+/**
+ * blend a solid color through a coverage mask over a row of pixels, e.g. a row of glyphs
+ * @param dst pixels to blend onto
+ * @param coverage coverage of each pixel between 0 and 255
+ * @param count number of pixels
+ * @param color ARGB8888 color with straight alpha
+ */
+void blit_a8(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color);
+
+/**
+ * blend a color over a rect of an ARGB8888 surface. The rect gets clipped by the clip rect of the
+ * surface.
+ * @param surface surface to draw on
+ * @param rect rect to fill
+ * @param color color to fill with
+ */
+void fill_rect(SDL_Surface *surface, SDL_Rect rect, RGB color);
+
+/**
+ * blend an ARGB8888 surface over another one. The destination gets clipped by its clip rect.
+ * @param src surface to blend
+ * @param dst surface to draw on
+ * @param x x coordinate of top left corner of src on dst
+ * @param y y coordinate of top left corner of src on dst
+ */
+void blit_surface(const SDL_Surface *src, SDL_Surface *dst, int x, int y);
+
+/**
+ * blend an ARGB8888 surface scaled to a rect over another one, sampling the nearest pixel. The
+ * destination gets clipped by its clip rect. Unlike SDL_BlitScaled this does not modify src, so
+ * multiple threads can draw the same surface at once.
+ * @param src surface to blend
+ * @param dst surface to draw on
+ * @param rect area of dst to scale src to
+ */
+void blit_scaled_surface(const SDL_Surface *src, SDL_Surface *dst, SDL_Rect rect);
+
+/**
+ * blend a color through a coverage mask over an ARGB8888 surface. The destination gets clipped
+ * by its clip rect.
+ * @param coverage coverage of each pixel between 0 and 255, row after row
+ * @param width width of mask
+ * @param height height of mask
+ * @param dst surface to draw on
+ * @param x x coordinate of top left corner of mask on dst
+ * @param y y coordinate of top left corner of mask on dst
+ * @param color color to blend
+ */
+void blit_a8_surface(const Uint8 *coverage, int width, int height, SDL_Surface *dst, int x, int y,
+                     RGB color);
+
+/**
+ * announce that a software renderer draws onto an ARGB8888 surface. Drawables then use the
+ * kernels directly on its pixels.
+ * @param renderer software renderer
+ * @param surface surface the renderer draws onto
+ */
+void register_target(SDL_Renderer *renderer, SDL_Surface *surface);
+
+/**
+ * forget the surface of a renderer
+ * @param renderer renderer that gets destroyed
+ */
+void unregister_target(SDL_Renderer *renderer);
+
+/**
+ * get the surface to draw onto directly instead of through a renderer. This is only possible if
+ * the renderer got registered, draws to the surface itself instead of to a texture and has no
+ * viewport offset. Pending draws of the renderer get flushed and the clip rect of the renderer is
+ * applied to the surface.
+ * @param renderer renderer to draw with
+ * @return surface to draw on. nullptr if drawing has to go through the renderer.
+ */
+SDL_Surface *target_of(SDL_Renderer *renderer);
+}}
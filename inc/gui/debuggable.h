@@ -28,6 +28,14 @@ protected:
     /** Constructor */
     Debuggable();
 
+    /**
+     * Copy constructor
+     * The debug drawables belong to the original and are not copied. The copy creates its own
+     * once its debug information gets initialised.
+     * @param debuggable object to copy
+     */
+    Debuggable(const Debuggable &debuggable);
+
 public:
     /** Destructor */
     ~Debuggable();
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include <SDL2/SDL.h>
 
@@ -12,20 +15,125 @@
 #include "positionable.h"
 #include "scrollable.h"
 #include "style.h"
+#include "../util/handle_table.h"
 
 namespace SDL_GUI {
 class InterfaceModel;
 /** base class for Objects that get rendered.  */
 class Drawable : public Hoverable, public Scrollable, public Attributable,
                  public Debuggable {
-    Drawable *_parent;                          /**< parent Drawable in drawable tree */
-    std::list<Drawable *> _children;            /**< list of child drawables in drawable tree */
-    std::list<Drawable *> _children_reversed;   /**< reversed list of childs */
-protected:
-    static const InterfaceModel *_interface_model;
+    /* transactions advance the geometry generation once on commit */
+    friend class TreeTransaction;
+
+    /** state that traversals do not read. It lives apart to keep drawables compact. */
+    struct Cold {
+        /** Typename of this drawable */
+        std::string _type;
+
+        /** function to call for debug information initialisation */
+        std::function<void ()> _init_debug_information_callback;
+
+        /** callbacks for recalculation */
+        std::vector<std::function<void(Drawable *)>> _recalculation_callbacks;
+    };
+
+    Drawable *_parent = nullptr;                /**< parent Drawable in drawable tree */
+    std::vector<Drawable *> _children;          /**< child drawables in drawable tree */
+    std::unique_ptr<Cold> _cold;                /**< rarely used state */
+    bool _cached = false;                       /**< flag that determines whether the subtree gets rendered to a layer */
+    mutable unsigned long _occluded_frame = 0;  /**< last frame in which this was hidden beneath opaque drawables */
+    Handle _handle;                             /**< stable reference to this drawable */
+
+    /* The absolute position and clip rect are derived from the parent and get resolved lazily.
+     * Every change of geometry anywhere increments _geometry_generation. A drawable verified in
+     * the current generation is up to date without looking at its parents. Otherwise it is up to
+     * date if its own geometry did not change and its parent did not get recomputed since.
+     * Scrolling does not change the stored geometry of any drawable. It is stored without the
+     * scroll positions and without the clip rects of scroll containers, both get applied when
+     * reading the geometry in window coordinates. */
+    mutable bool _geometry_dirty = true;                    /**< flag that determines whether the own geometry changed */
+    mutable unsigned long _geometry_stamp = 0;              /**< stamp of the last recomputation */
+    mutable unsigned long _parent_geometry_stamp = 0;       /**< stamp of parent at the last recomputation */
+    mutable unsigned long _verified_generation = 0;         /**< generation this got verified in */
+    mutable unsigned long _subtree_verified_generation = 0; /**< generation the whole subtree got verified in */
+    mutable const Drawable *_scroll_container = nullptr;    /**< closest parent that is a scroll container */
+
+    bool _layout_dirty = false;     /**< flag that determines whether layout() has to run */
+    bool _layout_pending = false;   /**< flag that determines whether layout() is due in subtree */
+
+    /** number of geometry changes of all drawables */
+    static std::atomic<unsigned long> _geometry_generation;
+
+    /** number of recomputations of all drawables */
+    static std::atomic<unsigned long> _geometry_stamps;
+
+    /**
+     * recompute the absolute position and clip rect if they are outdated. The parent must be up
+     * to date.
+     */
+    void resolve_from_parent() const;
+
+    /**
+     * resolve the geometry of all childs recursively. This must be up to date.
+     * @param generation current geometry generation
+     */
+    void resolve_children_geometry(unsigned long generation) const;
+
+    /** table of handles of all existing drawables */
+    static HandleTable<Drawable> _handles;
 
-    /** function to call for debug information initialisation */
-    std::function<void ()> _init_debug_information_callback;
+    /**
+     * render this drawable, its children, its border and its debug information
+     * @param renderer The applications renderer
+     * @param position position of this drawable
+     * @param parent_clip_rect clip rectangle of parent
+     * @param is_debug_information flag that determines whether this is debug information
+     */
+    void render_content(SDL_Renderer *renderer, Position position, SDL_Rect parent_clip_rect,
+                        bool is_debug_information) const;
+
+    /**
+     * get the offset of the stored geometry to window coordinates caused by scrolling. The
+     * geometry must be up to date.
+     * @return sum of the scroll positions of all scroll containers above this
+     */
+    Position scroll_offset() const;
+
+    /**
+     * get the clip rect of the childs in window coordinates while traversing the tree
+     * @param position position of this drawable in window
+     * @param parent_clip_rect clip rect of parent in window
+     * @return intersection of the own bounds with the clip rect of the parent. Empty if they do
+     *   not intersect.
+     */
+    SDL_Rect window_clip_rect(Position position, SDL_Rect parent_clip_rect) const;
+
+    /**
+     * render the subtree to its cached layer if that is outdated and copy the layer to the
+     * renderer
+     * @param renderer The applications renderer
+     * @param position position of this drawable
+     * @param parent_clip_rect clip rectangle of parent
+     * @return True if the layer got rendered. False if the subtree has to be rendered directly.
+     */
+    bool render_layer(SDL_Renderer *renderer, Position position, SDL_Rect parent_clip_rect) const;
+
+    /**
+     * copy the subtree defined by this drawable below an already copied parent. See snapshot().
+     * @param parent_copy copy of the parent. nullptr for the root of the snapshot.
+     * @return root of the copied subtree
+     */
+    Drawable *snapshot(Drawable *parent_copy) const;
+
+    /**
+     * delete a child that got removed from the tree. Subtrees of trees with an interface model
+     * get deleted by its reclaimer in the background. Their handles resolve to nullptr right away.
+     * @param child removed child
+     */
+    void dispose(Drawable *child);
+protected:
+    /** interface model of the tree this drawable belongs to. nullptr if it is not attached yet */
+    const InterfaceModel *_interface_model = nullptr;
 
     /** default debug information initialisation */
     void default_init_debug_information();
@@ -39,8 +147,13 @@ protected:
     Drawable(std::string type, Position position = {0,0},
              std::function<void ()> init_debug_information_callback = nullptr);
 
-    /** vector of callbacks for recalculation */
-    std::vector<std::function<void(Drawable *)>> _recalculation_callbacks;
+    /**
+     * Copy constructor
+     * The copy has neither parent nor children and gets the default debug information, since
+     * custom initialisation callbacks are bound to the original.
+     * @param drawable drawable to copy
+     */
+    Drawable(const Drawable &drawable);
 
     /** function to call before the drawable gets rendered */
     virtual void hook_pre_render() const {}
@@ -54,30 +167,109 @@ protected:
     /** @copydoc Scrollable::hook_post_scroll(Position) */
     void hook_post_scroll(Position scroll_offset) override;
 
+    /** @copydoc Scrollable::hook_post_toggle_scrolling() */
+    void hook_post_toggle_scrolling() override;
+
+    /**
+     * hook to execute after a child got moved, resized, added, removed, shown or hidden
+     * @param child changed child. nullptr if children got removed or reordered.
+     */
+    virtual void hook_post_child_change(Drawable *child) {(void) child;}
+
     /**
-     * recalculate absolute position of this and all childs with regard to the absolute position of
-     * the parent in the drawable tree
-     * @param parent_position absolute position of parent
+     * arrange the children and derive the own size from them. This gets called by
+     * update_layout() after layout() ran for all children, but only if a layout got requested.
      */
-    void apply_parents_absolute_position(Position parent_position);
+    virtual void layout() {}
 
     /**
-     * recalculate the clip rect of this and all childs with regard to the clip rect of the parent
-     * in the drawable tree
-     * @param parent_clip_rect clip rect of parent
+     * get the children without copying them, e.g. for layouts that visit them on every change
+     * @return list of children
+     */
+    const std::vector<Drawable *> &children_ref() const;
+
+    /**
+     * mark the layout of this drawable as outdated. It gets recomputed by the next
+     * update_layout() of any parent.
      */
-    void apply_parents_clip_rect(SDL_Rect parent_clip_rect);
+    void request_layout();
+
+    /** mark the absolute position and clip rect of this and all childs as outdated */
+    void invalidate_geometry();
 
     virtual Drawable *clone() const = 0;
 
 public:
-    const std::string _type;    /**< Typename of this drawable */
-    Style _style;       /**< Style */
+    Style _style;       /**< Style. Its hidden flag only changes with show() and hide(). */
 
     /** Default destructor */
     virtual ~Drawable();
 
-    static void set_interface_model(InterfaceModel *interface_model);
+    /**
+     * allocate memory for a drawable. Drawables of the same size share a slab allocator, so trees
+     * get built and torn down without going through malloc for every node and neighbouring nodes
+     * lie next to each other in memory. Setting the environment variable SDL_GUI_NO_SLAB disables
+     * this, e.g. for memory debuggers.
+     * @param size size of drawable
+     * @return allocated memory
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * free memory of a drawable
+     * @param drawable memory to free
+     * @param size size of drawable
+     */
+    static void operator delete(void *drawable, size_t size);
+
+    /**
+     * Setter for _interface_model of this and all childs
+     * This initialises the debug information that got deferred until a model is known.
+     * @param interface_model interface model of the tree
+     * @param is_debug_information flag that determines whether this is debug information
+     */
+    void set_interface_model(const InterfaceModel *interface_model,
+                             bool is_debug_information = false);
+
+    /**
+     * bring the absolute position and clip rect of this drawable up to date. Only this drawable and
+     * its parents get looked at.
+     */
+    void resolve_geometry() const override;
+
+    /**
+     * bring the absolute position and clip rect of this whole subtree up to date in a single top
+     * down pass. Subtrees without changes since the last pass get skipped. This has to be done
+     * before rendering.
+     */
+    void resolve_subtree_geometry() const;
+
+    /** @copydoc Positionable::absolute_position() */
+    Position absolute_position() const override;
+
+    /** @copydoc Positionable::clip_rect() */
+    SDL_Rect clip_rect() const override;
+
+    /**
+     * Getter for the typename
+     * @return name of drawable subclass
+     */
+    const std::string &type() const;
+
+    /**
+     * Getter for _handle
+     * Unlike pointers, handles may be kept after the drawable got deleted and passed between
+     * threads.
+     * @return this->_handle
+     */
+    Handle handle() const;
+
+    /**
+     * look up a drawable by its handle
+     * @param handle handle of drawable
+     * @return drawable. nullptr if it got deleted.
+     */
+    static Drawable *from_handle(Handle handle);
 
     /**
      * Getter for _parent
@@ -110,7 +302,7 @@ public:
     void add_child(Drawable *child, bool is_debug_information = false);
 
     /**
-     * add a vector of drawables as children
+     * add a vector of drawables as children. Derived state gets updated once for all of them.
      * @param children drawables to add as children
      * @param is_debug_information flag that determines if the added child is debug information.
      */
@@ -256,11 +448,21 @@ public:
         return f(this, aggregate(vec));
     }
 
-    /** initialise debug information */
+    /**
+     * recompute all outdated layouts in this subtree, children before their parents. Subtrees
+     * without outdated layouts get skipped. If a layout changes the size of its drawable the
+     * layout of the parent gets requested, so changes only travel up as far as they make a
+     * difference.
+     */
+    void update_layout();
+
+    /** initialise debug information. Inside a TreeTransaction this is deferred until commit. */
     void init_debug_information();
 
     /**
      * render the subtree this drawable is root of.
+     * Subtrees whose draw bounds and clip rect are both outside of the parents clip rect get
+     * skipped as a whole, since nothing in them can be visible.
      * @param renderer The applications renderer
      * @param parent_position position of parent Drawable
      * @param parent_clip_rect clip rectanlge of parent
@@ -284,6 +486,33 @@ public:
      */
     virtual void draw_border(SDL_Renderer *renderer, Position position) const;
 
+    /**
+     * get the area this drawable draws to. Drawing gets skipped if it is outside of the parents
+     * clip rect.
+     * @param position global offset in window
+     * @return bounding box of everything draw() and draw_border() touch
+     */
+    virtual SDL_Rect draw_bounds(Position position) const;
+
+    /**
+     * check if draw() completely fills draw_bounds() without any transparency
+     * @return True if nothing beneath this drawable is visible. False otherwise.
+     */
+    virtual bool is_opaque() const;
+
+    /**
+     * front to back pass over the draw order of this subtree. It collects the areas covered by
+     * opaque drawables and marks every drawable that is completely hidden beneath them as occluded
+     * for the given frame. Drawing of occluded drawables gets skipped by render().
+     * Subtrees of cached drawables are not visited since they are rendered as a single layer.
+     * @param parent_position position of parent Drawable
+     * @param parent_clip_rect clip rectangle of parent
+     * @param occluders areas covered by opaque drawables that are drawn later
+     * @param frame number of the frame to render next
+     */
+    void cull_occluded(Position parent_position, SDL_Rect parent_clip_rect,
+                       std::vector<SDL_Rect> *occluders, unsigned long frame) const;
+
     /**
      * add a callback function for data binding
      * @param callback callback function that gets executed every tick
@@ -303,13 +532,46 @@ public:
     void hide();
 
     /**
-     * Getter for the style's `hidden` value
-     * @return this->_style._hidden
+     * Getter for the `hidden` value. Traversals read it from the geometry store, where show()
+     * and hide() keep a copy of it.
+     * @return flag that determines whether this is hidden
      */
     bool is_hidden() const;
 
     /** copy the subtree defined by this drawable */
     Drawable *deepcopy() const;
+
+    /**
+     * copy the subtree defined by this drawable for rendering it on another thread. Unlike
+     * deepcopy() the copies keep the positions and clip rects of the originals as they are and
+     * get neither recalculation callbacks, debug information nor cached layers, so the snapshot
+     * can be rendered while the original tree keeps changing. The geometry of the subtree gets
+     * resolved first and the copies take it over as resolved, so rendering the snapshot does not
+     * recompute it.
+     * @return root of the copied subtree
+     */
+    Drawable *snapshot() const;
+
+    /**
+     * Setter for _cached
+     * If set, the subtree gets rendered once to an offscreen layer which then gets copied each
+     * frame until something in the subtree changes.
+     * @param cached flag that determines whether the subtree gets cached
+     */
+    void set_cached(bool cached);
+
+    /**
+     * Getter for _cached
+     * @return this->_cached
+     */
+    bool is_cached() const;
+
+    /**
+     * mark the cached layers of this and all parents as outdated. This gets called on all changes
+     * the tree can detect. Call it after changing _style directly. Inside a TreeTransaction this
+     * is deferred until commit.
+     */
+    void invalidate();
 };
 
 
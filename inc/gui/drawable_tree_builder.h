@@ -14,6 +14,7 @@ enum class Type {
     RECT,
     TEXT,
     VERTICAL_LINE,
+    STACK,
     NONE,
 };
 
@@ -22,6 +23,7 @@ static const std::map<std::string, Type> TYPE_MAP = {
     {"rect", Type::RECT},
     {"text", Type::TEXT},
     {"vertical-line", Type::VERTICAL_LINE},
+    {"stack", Type::STACK},
     {"", Type::NONE},
 };
 
@@ -35,6 +37,7 @@ enum class StyleType {
     POSITION_X,
     POSITION_Y,
     OVERFLOW,
+    CACHE,
 };
 
 /** mapping from xml attributy to StyleType */
@@ -47,6 +50,7 @@ static const std::map<std::string, StyleType> STYLE_TYPE_MAP = {
     {"x", StyleType::POSITION_X},
     {"y", StyleType::POSITION_Y},
     {"overflow", StyleType::OVERFLOW},
+    {"cache", StyleType::CACHE},
 };
 
 /** Treebuilder that builds a tree of drawables */
@@ -67,6 +71,13 @@ class DrawableTreeBuilder : public TreeBuilder<Drawable> {
      * @param color_value name of RGB color preset
      */
     static void set_color_of_drawable(Drawable *drawable, std::string color_value);
+
+    /**
+     * create a stack from its xml attributes direction, align, spacing and padding
+     * @param attributes xml attribute map
+     * @return stack
+     */
+    static Drawable *construct_stack(std::map<std::string, std::string> attributes);
 public:
     /**
      * Constructor
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+namespace SDL_GUI {
+/**
+ * Records rendered frames without stalling the render loop.
+ * Every captured frame gets read back from the renderer into one of a fixed number of reusable
+ * buffers. A writer thread encodes the buffers in the background and returns them to the pool.
+ * If all buffers are still waiting to be written, the frame gets dropped. Once writing failed, no
+ * further frames get written.
+ * SIGPIPE is blocked on the writer thread only, so a terminated encoder makes writing fail
+ * instead of killing the application.
+ */
+class FrameCapture {
+public:
+    /** how frames get written */
+    enum class Format {
+        PNG,    /**< one PNG file per frame in a directory */
+        RAW,    /**< ARGB8888 pixels of all frames one after another in a file or pipe */
+    };
+
+private:
+    /** buffer holding the pixels of a single frame */
+    struct Frame {
+        std::vector<Uint32> _pixels;    /**< ARGB8888 pixels, row after row */
+        unsigned long _number = 0;      /**< number of frame since start of capture */
+    };
+
+    std::string _destination;       /**< directory, file, "-" for stdout or "|command" */
+    Format _format;                 /**< how frames get written */
+    int _width;                     /**< width of frames */
+    int _height;                    /**< height of frames */
+
+    std::vector<Frame> _frames;     /**< all buffers */
+    std::list<Frame *> _free;       /**< buffers that can be captured into */
+    std::list<Frame *> _pending;    /**< captured buffers waiting for the writer, oldest first */
+    std::mutex _mutex;              /**< mutex guarding _free, _pending and _is_stopping */
+    std::condition_variable _frame_pending; /**< notified when a frame got captured */
+    bool _is_stopping = false;      /**< flag that tells the writer to finish */
+    std::thread _writer;            /**< thread writing the captured frames */
+
+    FILE *_stream = nullptr;        /**< stream raw frames get written to */
+    bool _is_pipe = false;          /**< flag that determines whether _stream is a process */
+
+    unsigned long _captured = 0;            /**< number of frames offered for capturing */
+    std::atomic<unsigned long> _written = 0;    /**< number of frames written */
+    std::atomic<unsigned long> _dropped = 0;    /**< number of frames dropped for lack of buffers */
+    std::atomic<unsigned long> _unwritten = 0;  /**< number of captured frames not written */
+    std::atomic<bool> _failed = false;      /**< flag that determines whether writing failed */
+
+    /** write captured frames until stopped and close the destination */
+    void write_frames();
+
+    /** close the stream raw frames get written to */
+    void close_stream();
+
+    /**
+     * write a single frame
+     * @param frame frame to write
+     * @return true on success
+     */
+    bool write(const Frame *frame);
+
+public:
+    /**
+     * Constructor
+     * @param destination directory for PNG files. For raw frames a file path, "-" for stdout
+     *   or "|command" to pipe them into a command, e.g. an encoder.
+     * @param format how frames get written
+     * @param width width of frames
+     * @param height height of frames
+     * @param buffers number of frames that can wait to be written
+     */
+    FrameCapture(std::string destination, Format format, int width, int height,
+                 unsigned buffers = 4);
+
+    /** Destructor. This waits until all captured frames are written. */
+    ~FrameCapture();
+
+    /** wait until all captured frames are written and close the destination */
+    void finish();
+
+    /**
+     * read back the current frame of a renderer. Call it before the frame gets presented. If no
+     * buffer is free or the capture is finished, the frame gets dropped.
+     * @param renderer renderer to read from
+     * @return true if the frame got captured
+     */
+    bool capture(SDL_Renderer *renderer);
+
+    /**
+     * Getter for _written
+     * @return this->_written
+     */
+    unsigned long written() const;
+
+    /**
+     * Getter for _dropped
+     * @return this->_dropped
+     */
+    unsigned long dropped() const;
+
+    /**
+     * Getter for _unwritten
+     * @return this->_unwritten
+     */
+    unsigned long unwritten() const;
+
+    /**
+     * Getter for _failed
+     * @return this->_failed
+     */
+    bool failed() const;
+
+    /**
+     * parse the name of a format
+     * @param name "png" or "raw"
+     * @param[out] format parsed format
+     * @return true if the name is known
+     */
+    static bool parse_format(const std::string &name, Format *format);
+};
+}
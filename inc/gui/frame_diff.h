@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+namespace SDL_GUI {
+/** result of comparing two rendered frames */
+struct FrameDiff {
+    bool _same_size = true;             /**< flag that determines whether the sizes match */
+    unsigned long _differing_pixels = 0;    /**< number of pixels exceeding the tolerance */
+    unsigned _max_difference = 0;       /**< largest difference of a single channel */
+    SDL_Rect _bounds = {0, 0, 0, 0};    /**< bounding box of all differing pixels */
+
+    /**
+     * check whether the frames are considered equal
+     * @return whether the sizes match and no pixel exceeds the tolerance
+     */
+    bool equal() const {
+        return this->_same_size and this->_differing_pixels == 0;
+    }
+};
+
+/**
+ * compare two frames pixel by pixel, e.g. a headless rendered frame against a golden image
+ * @param expected expected frame
+ * @param actual actual frame
+ * @param tolerance largest difference of a single channel that is not counted as difference
+ * @param[out] diff_image if given and of the same size, differing pixels get painted red on it and
+ *                        all other pixels get a faded version of the expected frame
+ * @return result of comparison
+ */
+FrameDiff compare_frames(SDL_Surface *expected, SDL_Surface *actual, unsigned tolerance = 0,
+                         SDL_Surface *diff_image = nullptr);
+}
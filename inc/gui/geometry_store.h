@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "position.h"
+
+namespace SDL_GUI {
+/**
+ * Geometry of a single positionable object. It holds everything layout, culling and rendering read
+ * of an object and fills exactly one cache line, so a traversal touches one line per object.
+ */
+struct alignas(64) Geometry {
+    Position _position;                              /**< position relative to parent */
+    Position _absolute_position;                     /**< position in window */
+    unsigned _width = 0;                             /**< width */
+    unsigned _height = 0;                            /**< height */
+    SDL_Rect _clip_rect = {0, 0, 0, 0};              /**< clip rect */
+    SDL_Rect _parent_clip_rect = {0, 0, 1920, 1080}; /**< clip rect of parent */
+    bool _hidden = false;                            /**< hidden flag */
+};
+
+/**
+ * Storage of the geometry of all positionable objects.
+ * The geometry gets read by every layout, culling and render pass, while the rest of a drawable is
+ * rarely touched. Entries are packed into chunks that never move, so objects keep a pointer to
+ * their entry and may read it while other threads add entries. The store grows by further chunks
+ * as needed.
+ * Each thread allocates from a chunk and a free list of its own, so creating and deleting objects
+ * takes no lock. Released entries get handed to the other threads in batches, e.g. from the thread
+ * that deletes removed subtrees to the one that builds new ones.
+ */
+class GeometryStore {
+public:
+    /** number of entries per chunk */
+    static const size_t CHUNK_SIZE = 4096;
+
+    /** number of released entries a thread hands to the other threads at once */
+    static const size_t BATCH_SIZE = 256;
+
+private:
+    /** entries allocated at once */
+    struct Chunk {
+        Geometry _entries[CHUNK_SIZE];  /**< entries */
+        Chunk *_next = nullptr;         /**< chunk allocated before */
+    };
+
+    /** released entries */
+    struct Batch {
+        std::vector<Geometry *> _entries;   /**< released entries */
+        Batch *_next = nullptr;             /**< batch handed over before */
+    };
+
+    /** entries reserved by a single thread */
+    struct Local;
+
+    /** hands the entries of a thread over to the other threads when it ends */
+    struct LocalOwner;
+
+    std::atomic<Chunk *> _chunks = nullptr;     /**< all chunks, most recently allocated first */
+    std::atomic<Batch *> _batches = nullptr;    /**< released entries handed over by threads */
+    std::atomic<size_t> _size = 0;              /**< number of entries in use */
+
+    /** Default constructor */
+    GeometryStore() = default;
+
+    /** Destructor */
+    ~GeometryStore();
+
+    /**
+     * get the entries reserved by the calling thread
+     * @return entries of calling thread
+     */
+    static Local &local();
+
+    /**
+     * make released entries available to all threads
+     * @param batch released entries
+     */
+    void hand_over(Batch *batch);
+
+    /** hand all entries reserved by the calling thread over to the other threads */
+    void hand_over_local();
+
+public:
+    GeometryStore(const GeometryStore &) = delete;
+    GeometryStore &operator=(const GeometryStore &) = delete;
+
+    /**
+     * get the store all positionable objects share. It never gets destroyed, since objects may
+     * outlive static objects.
+     * @return shared store
+     */
+    static GeometryStore *instance();
+
+    /**
+     * add an entry. Positions and sizes are zero, the parent clip rect covers a full hd screen.
+     * Throws std::bad_alloc if no further chunk can be allocated.
+     * @return entry. It keeps its address until it gets released.
+     */
+    Geometry *allocate();
+
+    /**
+     * remove an entry. It may get reused afterwards, also by other threads.
+     * @param geometry entry to remove
+     */
+    void release(Geometry *geometry);
+
+    /**
+     * get the number of entries in use
+     * @return number of entries in use
+     */
+    size_t size() const;
+};
+}
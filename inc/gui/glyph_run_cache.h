@@ -0,0 +1,146 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "rgb.h"
+
+namespace SDL_GUI {
+/** single line of text rendered in a font and color */
+struct GlyphRun {
+    int _width = 0;                         /**< width of text */
+    int _height = 0;                        /**< height of text */
+    std::shared_ptr<SDL_Surface> _surface;  /**< rendered text. nullptr for empty texts */
+    std::vector<Uint8> _coverage;           /**< alpha of _surface, row after row */
+
+    /** uploads of _surface, one per renderer that drew the run */
+    mutable std::vector<std::pair<SDL_Renderer *, SDL_Texture *>> _textures;
+
+    /** mutex guarding _textures */
+    mutable std::mutex _textures_mutex;
+
+    /** Default constructor */
+    GlyphRun() = default;
+
+    /**
+     * Destructor
+     * Runs may get destroyed on any thread. Their textures get destroyed by
+     * GlyphRunCache::collect() on the render thread.
+     */
+    ~GlyphRun();
+
+    GlyphRun(const GlyphRun &) = delete;
+    GlyphRun &operator=(const GlyphRun &) = delete;
+
+    /**
+     * get the upload of the run for a renderer. It gets created the first time the run gets drawn
+     * with the renderer. This has to be called on the thread that renders with the renderer.
+     * @param renderer renderer to draw with
+     * @return texture. nullptr for empty texts or if it could not be created.
+     */
+    SDL_Texture *texture(SDL_Renderer *renderer) const;
+};
+
+/**
+ * Rendered lines of text in a single font and color, identified by their text.
+ * Widgets that show many short texts, like the cells of a table, repeat the same texts over and
+ * over. Rendering each distinct text once and reusing it saves rasterising glyphs every frame.
+ * If more than the capacity of runs are cached the least recently used ones get evicted.
+ * Runs only get rendered by acquire(), which has to be called on the thread that updates the
+ * drawable tree, since fonts must not be used by multiple threads at once. Any thread may look
+ * up runs that already exist.
+ * Runs keep one texture per renderer they got drawn with, so accelerated renderers only upload a
+ * text once. Textures of destroyed runs get destroyed by collect().
+ */
+class GlyphRunCache {
+    /* runs hand over their textures when they get destroyed */
+    friend struct GlyphRun;
+
+    /** cached run */
+    struct Entry {
+        std::shared_ptr<const GlyphRun> _run;           /**< rendered text */
+        std::list<std::string>::iterator _lru_position; /**< position in _lru */
+    };
+
+    TTF_Font *_font;                    /**< font to render texts in */
+    RGB _color;                         /**< color to render texts in */
+    size_t _capacity;                   /**< maximum number of runs */
+    std::map<std::string, Entry, std::less<>> _entries; /**< mapping from texts to runs */
+    std::list<std::string> _lru;        /**< texts, most recently used first */
+    unsigned long _hits = 0;            /**< number of requests of cached runs */
+    unsigned long _misses = 0;          /**< number of requests of missing runs */
+    mutable std::mutex _mutex;          /**< guards all members */
+
+    /** textures of destroyed runs per renderer that wait for collect() */
+    static std::map<SDL_Renderer *, std::vector<SDL_Texture *>> _released;
+
+    /** mutex guarding _released */
+    static std::mutex _released_mutex;
+
+    /**
+     * rasterise a text
+     * @param text text to render
+     * @return rendered text
+     */
+    std::shared_ptr<const GlyphRun> render(std::string_view text) const;
+
+public:
+    /**
+     * Constructor
+     * @param font font to render texts in
+     * @param color color to render texts in
+     * @param capacity maximum number of runs
+     */
+    GlyphRunCache(TTF_Font *font, RGB color, size_t capacity = 8192);
+
+    /**
+     * get the run of a text. It gets rendered if it is missing.
+     * @param text text to get run of
+     * @return rendered text
+     */
+    std::shared_ptr<const GlyphRun> acquire(std::string_view text);
+
+    /**
+     * get the run of a text if it is cached
+     * @param text text to get run of
+     * @return rendered text. nullptr if it is not cached.
+     */
+    std::shared_ptr<const GlyphRun> lookup(std::string_view text);
+
+    /**
+     * destroy the textures of all runs that got destroyed since the last call. This has to be
+     * called on the thread that renders with the renderer, regularly and once more after all
+     * drawables got deleted, before the renderer gets destroyed.
+     * @param renderer the renderer
+     */
+    static void collect(SDL_Renderer *renderer);
+
+    /**
+     * get the number of cached runs
+     * @return number of runs
+     */
+    size_t size() const;
+
+    /**
+     * Getter for _hits
+     * @return this->_hits
+     */
+    unsigned long hits() const;
+
+    /**
+     * Getter for _misses
+     * @return this->_misses
+     */
+    unsigned long misses() const;
+};
+}
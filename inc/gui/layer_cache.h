@@ -0,0 +1,146 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+namespace SDL_GUI {
+class Drawable;
+/**
+ * Offscreen textures holding the rendered subtrees of drawables that have layer caching enabled.
+ * Every layer gets accounted with its estimated size in video memory. If the sum exceeds the
+ * budget, the least recently used layers get evicted.
+ * Drawables may get destroyed on other threads than the render thread. Therefore removed layers
+ * only get destroyed the next time the render thread calls collect() or acquire().
+ * Layers that are being rendered to are pinned. They neither get evicted nor destroyed until they
+ * get unpinned, since rendering a nested cached drawable may acquire further layers meanwhile.
+ */
+class LayerCache {
+    /** offscreen texture of a single drawable */
+    struct Layer {
+        SDL_Texture *_texture = nullptr;    /**< texture the subtree got rendered to */
+        int _width = 0;                     /**< width of texture */
+        int _height = 0;                    /**< height of texture */
+        bool _valid = false;                /**< flag that determines whether the content is current */
+        std::list<const Drawable *>::iterator _lru_position;    /**< position in _lru */
+    };
+
+    std::map<const Drawable *, Layer> _layers;  /**< mapping from drawables to their layers */
+    std::list<const Drawable *> _lru;           /**< drawables with layers, most recently used first */
+    size_t _budget;                             /**< maximum number of bytes for all layers */
+    size_t _bytes = 0;                          /**< number of bytes used by all layers */
+    std::vector<SDL_Texture *> _released;       /**< textures of removed layers */
+    std::vector<SDL_Texture *> _pinned;         /**< textures that are being rendered to */
+    mutable std::mutex _mutex;                  /**< guards all members */
+
+    /**
+     * estimate the number of bytes a layer texture needs
+     * @param width width of layer
+     * @param height height of layer
+     * @return estimated number of bytes
+     */
+    static size_t bytes_of(int width, int height);
+
+    /**
+     * remove a layer from the cache. Its texture gets destroyed on the next collection.
+     * @param it iterator pointing to the layer
+     */
+    void destroy(std::map<const Drawable *, Layer>::iterator it);
+
+    /**
+     * check whether a layer texture is being rendered to. The caller must hold _mutex.
+     * @param texture layer texture
+     * @return whether texture is pinned
+     */
+    bool is_pinned(const SDL_Texture *texture) const;
+
+    /**
+     * destroy the textures of all removed layers that are not pinned. The caller must hold _mutex.
+     */
+    void destroy_released();
+
+    /** evict least recently used layers that are not pinned until the budget is met */
+    void evict();
+
+public:
+    /**
+     * Constructor
+     * @param budget maximum number of bytes for all layers
+     */
+    LayerCache(size_t budget = 64 * 1024 * 1024);
+
+    /** Destructor */
+    ~LayerCache();
+
+    /**
+     * get the up to date layer of a drawable and mark it as most recently used
+     * @param drawable drawable to get layer for
+     * @return layer texture. nullptr if there is no valid layer.
+     */
+    SDL_Texture *find(const Drawable *drawable);
+
+    /**
+     * get a layer for a drawable to render its subtree to. An existing layer gets reused if the
+     * size matches. The returned layer counts as valid and stays pinned until it gets passed to
+     * unpin(). This must be called on the render thread.
+     * @param drawable drawable to get layer for
+     * @param renderer renderer to create the layer texture with
+     * @param width width of layer
+     * @param height height of layer
+     * @return layer texture. nullptr if the renderer does not support render targets.
+     */
+    SDL_Texture *acquire(const Drawable *drawable, SDL_Renderer *renderer, int width, int height);
+
+    /**
+     * allow a layer returned by acquire() to get evicted and destroyed again
+     * @param texture layer texture
+     */
+    void unpin(SDL_Texture *texture);
+
+    /**
+     * mark the layer of a drawable as outdated
+     * @param drawable drawable whose layer is outdated
+     */
+    void invalidate(const Drawable *drawable);
+
+    /** mark all layers as outdated */
+    void invalidate_all();
+
+    /**
+     * remove the layer of a drawable. This may be called from any thread.
+     * @param drawable drawable whose layer gets removed
+     */
+    void release(const Drawable *drawable);
+
+    /** destroy the textures of all removed layers. This must be called on the render thread. */
+    void collect();
+
+    /**
+     * Getter for _bytes
+     * @return this->_bytes
+     */
+    size_t bytes() const;
+
+    /**
+     * Getter for _budget
+     * @return this->_budget
+     */
+    size_t budget() const;
+
+    /**
+     * Setter for _budget
+     * This evicts layers if the new budget is exceeded.
+     * @param budget maximum number of bytes for all layers
+     */
+    void set_budget(size_t budget);
+
+    /**
+     * get the number of existing layers
+     * @return number of layers
+     */
+    size_t size() const;
+};
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+
+#include "drawable.h"
+#include "position.h"
+#include "style.h"
+#include "../util/mpsc_queue.h"
+
+namespace SDL_GUI {
+/**
+ * Queue of changes to the drawable tree that may get filled from any thread.
+ * Worker threads must not touch the tree while it gets updated or rendered. Instead they queue
+ * mutations here which get applied in one batch by the thread that owns the tree. Drawables are
+ * addressed by their handle since pointers to drawables may dangle once the mutation gets applied.
+ * Mutations whose drawable got deleted in the meantime are skipped.
+ */
+class MutationQueue {
+public:
+    /** kind of change */
+    enum class Type {
+        SET_TEXT,       /**< replace the text of a Text drawable */
+        SET_POSITION,   /**< move a drawable inside its parent */
+        ADD_CHILD,      /**< add a drawable as child */
+        REMOVE,         /**< remove a drawable with all its children */
+        SET_STYLE,      /**< replace the style of a drawable */
+    };
+
+    /** single change to the drawable tree */
+    struct Mutation {
+        Type _type;                     /**< kind of change */
+        Handle _target;                 /**< handle of drawable to change */
+        std::string _text = "";         /**< new text for SET_TEXT */
+        Position _position = {0, 0};    /**< new position for SET_POSITION */
+        Style _style = Style();         /**< new style for SET_STYLE */
+        Drawable *_child = nullptr;     /**< drawable to add for ADD_CHILD */
+    };
+
+protected:
+    MPSCQueue<Mutation> _queue;     /**< queued mutations */
+
+    /**
+     * apply a single mutation
+     * @param mutation mutation to apply
+     * @return whether the target still exists
+     */
+    bool apply_mutation(Mutation &mutation);
+
+public:
+    /** Default constructor */
+    MutationQueue() = default;
+
+    /** Destructor. Drawables of unapplied ADD_CHILD mutations get deleted. */
+    ~MutationQueue();
+
+    /**
+     * queue a change of text
+     * @param target handle of Text drawable to change
+     * @param text new text
+     */
+    void set_text(Handle target, std::string text);
+
+    /**
+     * queue a change of position
+     * @param target handle of drawable to move
+     * @param position new position inside its parent
+     */
+    void set_position(Handle target, Position position);
+
+    /**
+     * queue adding a drawable to the tree. The queue takes ownership of the child until it is
+     * applied, the child gets deleted if the target does not exist.
+     * @param target handle of parent drawable
+     * @param child drawable to add. It must not be part of a tree yet.
+     */
+    void add_child(Handle target, Drawable *child);
+
+    /**
+     * queue the removal of a drawable including its subtree
+     * @param target handle of drawable to remove
+     */
+    void remove(Handle target);
+
+    /**
+     * queue a change of style
+     * @param target handle of drawable to change
+     * @param style new style
+     */
+    void set_style(Handle target, Style style);
+
+    /**
+     * apply all queued mutations in the order they got queued. This must only be called by the
+     * thread that owns the tree.
+     * @return number of applied mutations whose target still exists
+     */
+    unsigned apply();
+
+    /**
+     * check whether nothing is queued
+     * @return whether nothing is queued
+     */
+    bool empty() const;
+};
+}
@@ -4,25 +4,129 @@
 
 #include <SDL2/SDL.h>
 
+#include "geometry_store.h"
 #include "position.h"
 
 namespace SDL_GUI {
 /** Objects consisting out of a position (relative and absolute), width and height */
 class Positionable {
 private:
+    /** geometry of this object in the GeometryStore */
+    Geometry *_geometry = GeometryStore::instance()->allocate();
+
     void init();
 protected:
-    Position _position;             /**< objects position relative to parent */
-    Position _absolute_position;    /**< objects absolute position in window */
-    unsigned _width = 0;            /**< objects width */
-    unsigned _height = 0;           /**< objects height */
+    /**
+     * get the position relative to parent in the geometry store
+     * @return objects position relative to parent
+     */
+    Position &position_ref() {
+        return this->_geometry->_position;
+    }
+
+    /** @copydoc position_ref() */
+    const Position &position_ref() const {
+        return this->_geometry->_position;
+    }
+
+    /**
+     * get the absolute position in the geometry store
+     * @return objects absolute position in window
+     */
+    Position &absolute_position_ref() {
+        return this->_geometry->_absolute_position;
+    }
+
+    /** @copydoc absolute_position_ref() */
+    const Position &absolute_position_ref() const {
+        return this->_geometry->_absolute_position;
+    }
+
+    /**
+     * get the width in the geometry store
+     * @return objects width
+     */
+    unsigned &width_ref() {
+        return this->_geometry->_width;
+    }
+
+    /** @copydoc width_ref() */
+    const unsigned &width_ref() const {
+        return this->_geometry->_width;
+    }
+
+    /**
+     * get the height in the geometry store
+     * @return objects height
+     */
+    unsigned &height_ref() {
+        return this->_geometry->_height;
+    }
+
+    /** @copydoc height_ref() */
+    const unsigned &height_ref() const {
+        return this->_geometry->_height;
+    }
+
+    /**
+     * get the clip rect of the parent in the geometry store
+     * @return parents clip rect
+     */
+    SDL_Rect &parent_clip_rect_ref() {
+        return this->_geometry->_parent_clip_rect;
+    }
 
-    SDL_Rect _parent_clip_rect = {0,0,1920,1080};   /**< parents clip rect */
-    SDL_Rect _clip_rect;                            /**< clip rect */
+    /** @copydoc parent_clip_rect_ref() */
+    const SDL_Rect &parent_clip_rect_ref() const {
+        return this->_geometry->_parent_clip_rect;
+    }
+
+    /**
+     * get the clip rect in the geometry store
+     * @return clip rect
+     */
+    SDL_Rect &clip_rect_ref() {
+        return this->_geometry->_clip_rect;
+    }
+
+    /** @copydoc clip_rect_ref() */
+    const SDL_Rect &clip_rect_ref() const {
+        return this->_geometry->_clip_rect;
+    }
+
+    /**
+     * get the hidden flag in the geometry store
+     * @return flag that determines whether this object is hidden
+     */
+    bool &hidden_ref() {
+        return this->_geometry->_hidden;
+    }
+
+    /** @copydoc hidden_ref() */
+    const bool &hidden_ref() const {
+        return this->_geometry->_hidden;
+    }
 
     /** Default constructor */
     Positionable() = default;
 
+    /**
+     * Copy constructor
+     * The copy gets its own entry in the geometry store.
+     * @param positionable object to copy
+     */
+    Positionable(const Positionable &positionable);
+
+    /**
+     * Copy assignment
+     * @param positionable object to copy the geometry of
+     * @return this
+     */
+    Positionable &operator=(const Positionable &positionable);
+
+    /** Destructor */
+    ~Positionable();
+
     /**
      * Hook to execute after move
      * @param position moving that happened
@@ -36,6 +140,12 @@ protected:
      */
     virtual void hook_post_resize(unsigned width, unsigned height) {(void)width; (void)height;}
 public:
+    /**
+     * bring derived geometry like the absolute position and the clip rect up to date. This gets
+     * called before they are read.
+     */
+    virtual void resolve_geometry() const {}
+
     /**
      * Constructor
      * @param position position relative to parent
@@ -126,13 +236,13 @@ public:
      * getter for _absolute_position
      * @returns absolute position of object
      */
-    Position absolute_position() const;
+    virtual Position absolute_position() const;
 
     /**
      * getter for _clip_rect
      * @returns clip_rect
      */
-    SDL_Rect clip_rect() const;
+    virtual SDL_Rect clip_rect() const;
 
     /**
      * getter for _position._x
@@ -14,5 +14,7 @@ public:
         : Drawable("Circle", center), _radius(radius)  {}
 
     void draw(SDL_Renderer *renderer, Position position) const override;
+
+    SDL_Rect draw_bounds(Position position) const override;
 };
 }
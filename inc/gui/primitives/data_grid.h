@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL_ttf.h>
+
+#include "rect.h"
+#include "../glyph_run_cache.h"
+#include "../../util/column_store.h"
+#include "../../util/thread_pool.h"
+
+namespace SDL_GUI {
+/**
+ * Scrollable table of text cells with a header row.
+ * The cells are kept in a ColumnStore instead of one Text drawable per cell. Only the cells inside
+ * the grid get drawn, from glyph runs that are shared by all cells with the same text. The runs of
+ * the visible cells get rendered on update(), cells whose run is still missing while drawing stay
+ * empty for a frame.
+ * Sorting and filtering run on a worker thread on the data as it was when they got requested. The
+ * resulting row order gets swapped in as a whole by the next update(), so drawing never sees a
+ * partial result. Requests that got superseded before they finished are dropped.
+ */
+class DataGrid : public Rect {
+    /** indices of the displayed rows in the order they get displayed */
+    using RowOrder = std::vector<uint32_t>;
+
+    std::shared_ptr<const ColumnStore> _data;           /**< displayed cells */
+    std::shared_ptr<const RowOrder> _order;             /**< displayed rows. nullptr for all */
+    std::vector<unsigned> _column_widths;               /**< widths of columns */
+    unsigned _row_height;                               /**< height of header and every row */
+    std::shared_ptr<GlyphRunCache> _glyph_runs;         /**< rendered cell texts */
+
+    size_t _sort_column = SIZE_MAX;     /**< column to sort by. SIZE_MAX if unsorted */
+    bool _ascending = true;             /**< flag that determines the sort direction */
+    size_t _filter_column = SIZE_MAX;   /**< column to filter by. SIZE_MAX if unfiltered */
+    std::string _filter_text;           /**< text the cells of _filter_column have to contain */
+
+    ThreadPool *_workers = nullptr;                 /**< sorts and filters. created on first use */
+    std::mutex _pending_mutex;                      /**< guards _pending_order and the queries */
+    std::shared_ptr<const RowOrder> _pending_order; /**< finished order not yet displayed */
+    unsigned long _query = 0;                       /**< number of the last requested order */
+    unsigned long _pending_query = 0;               /**< number of the last finished order */
+    bool _runs_outdated = true;                     /**< flag that determines whether cells moved */
+
+    /** derive the scroll limits from the size of the table */
+    void update_scroll_limits();
+
+    /** compute the row order for the current sort and filter on a worker thread */
+    void request_order();
+
+    /**
+     * get the range of displayed rows that are inside the grid
+     * @param[out] first index of first visible row in _order
+     * @param[out] last index after the last visible row in _order
+     */
+    void visible_rows(size_t *first, size_t *last) const;
+
+    /**
+     * get the range of columns that are inside the grid
+     * @param[out] first index of first visible column
+     * @param[out] last index after the last visible column
+     * @param[out] x horizontal offset of first visible column from the left of the grid
+     */
+    void visible_columns(size_t *first, size_t *last, int *x) const;
+
+    /**
+     * draw a single cell
+     * @param renderer renderer to draw on
+     * @param surface surface of software renderer. nullptr for other renderers
+     * @param area part of the grid that may be drawn to
+     * @param cell area of the cell in window coordinates
+     * @param text text of the cell
+     */
+    void draw_cell(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Rect area, SDL_Rect cell,
+                   std::string_view text) const;
+
+protected:
+    Drawable *clone() const override;
+
+    /**
+     * Copy constructor
+     * The copy shares data, row order and glyph runs, but not the running sorts and filters.
+     * @param grid grid to copy
+     */
+    DataGrid(const DataGrid &grid);
+
+    /** @copydoc Drawable::hook_post_scroll(Position) */
+    void hook_post_scroll(Position scroll_offset) override;
+
+    /** @copydoc Drawable::hook_post_resize(unsigned, unsigned) */
+    void hook_post_resize(unsigned width, unsigned height) override;
+
+public:
+    /**
+     * Constructor
+     * @param font font to draw cells in
+     * @param data cells to display
+     * @param position local position inside parent drawable
+     * @param width width of grid
+     * @param height height of grid
+     * @param column_width initial width of every column
+     * @param row_height height of header and every row. 0 for the line skip of the font
+     */
+    DataGrid(TTF_Font *font, std::shared_ptr<const ColumnStore> data, Position position,
+             unsigned width, unsigned height, unsigned column_width = 100,
+             unsigned row_height = 0);
+
+    /** Destructor. Waits for running sorts and filters. */
+    ~DataGrid();
+
+    /**
+     * replace the displayed cells. Sort and filter get applied to the new data.
+     * @param data cells to display
+     */
+    void set_data(std::shared_ptr<const ColumnStore> data);
+
+    /**
+     * Getter for _data
+     * @return this->_data
+     */
+    std::shared_ptr<const ColumnStore> data() const;
+
+    /**
+     * get the number of displayed rows. This changes once sorts and filters got swapped in.
+     * @return number of rows that pass the filter
+     */
+    size_t displayed_rows() const;
+
+    /**
+     * change the width of a column
+     * @param column index of column
+     * @param width width of column
+     */
+    void set_column_width(size_t column, unsigned width);
+
+    /**
+     * sort the rows by a column. Cells get compared as numbers if all of them are numbers.
+     * @param column index of column. SIZE_MAX to restore the order of the data.
+     * @param ascending flag that determines the sort direction
+     */
+    void sort(size_t column, bool ascending = true);
+
+    /**
+     * only display rows whose cell in a column contains a text
+     * @param column index of column
+     * @param text text to search for. Empty to remove the filter.
+     */
+    void filter(size_t column, std::string text);
+
+    /**
+     * check whether sorts or filters are still running or not yet swapped in
+     * @return whether the displayed order is outdated
+     */
+    bool is_pending();
+
+    /** wait until all sorts and filters are done. They get swapped in by the next update() */
+    void wait();
+
+    /**
+     * Getter for _glyph_runs
+     * @return this->_glyph_runs
+     */
+    const GlyphRunCache *glyph_runs() const;
+
+    /** swap in finished sorts and filters and render the glyph runs of all visible cells */
+    void update() override;
+
+    void draw(SDL_Renderer *renderer, Position position) const override;
+};
+}
@@ -25,6 +25,8 @@ public:
 
     void draw(SDL_Renderer *renderer, Position position) const override;
 
+    SDL_Rect draw_bounds(Position position) const override;
+
     /**
      * setter for _end
      * @param position end relative to begin
@@ -30,5 +30,7 @@ public:
     void draw(SDL_Renderer *renderer, Position position) const override;
 
     void draw_border(SDL_Renderer *renderer, Position position) const override;
+
+    SDL_Rect draw_bounds(Position position) const override;
 };
 }
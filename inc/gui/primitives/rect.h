@@ -29,5 +29,7 @@ public:
 
 
     void draw(SDL_Renderer *renderer, Position position) const override;
+
+    bool is_opaque() const override;
 };
 }
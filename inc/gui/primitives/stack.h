@@ -0,0 +1,100 @@
+#pragma once
+
+#include "rect.h"
+
+namespace SDL_GUI {
+/**
+ * Rect that places its children one after another and sizes itself to fit them.
+ * Children get laid out along the main axis in the order they were added, with a fixed spacing
+ * between them and a padding around all of them. Hidden children take no space. On the cross axis
+ * the children are aligned to the start, the center or the end of the stack.
+ * The layout only gets recomputed if a child got resized, added, removed, shown or hidden. If that
+ * does not change the size of the stack, its parents are not affected.
+ */
+class Stack : public Rect {
+public:
+    /** axis children get placed along */
+    enum class Direction {
+        VERTICAL,   /**< top to bottom */
+        HORIZONTAL, /**< left to right */
+    };
+
+    /** placement of children on the cross axis */
+    enum class Alignment {
+        START,  /**< left or top */
+        CENTER, /**< centered */
+        END,    /**< right or bottom */
+    };
+
+private:
+    Direction _direction;   /**< axis children get placed along */
+    Alignment _alignment = Alignment::START;    /**< placement of children on the cross axis */
+    unsigned _spacing = 0;  /**< space between two children */
+    unsigned _padding = 0;  /**< space between the border and the children */
+
+protected:
+    Drawable *clone() const override;
+
+    /** @copydoc Drawable::hook_post_child_change(Drawable *) */
+    void hook_post_child_change(Drawable *child) override;
+
+    /** @copydoc Drawable::layout() */
+    void layout() override;
+
+public:
+    /**
+     * Constructor
+     * @param direction axis children get placed along
+     * @param position local position inside parent drawable
+     */
+    Stack(Direction direction = Direction::VERTICAL, Position position = {0, 0});
+
+    /**
+     * Getter for _direction
+     * @return this->_direction
+     */
+    Direction direction() const;
+
+    /**
+     * Setter for _direction
+     * @param direction axis children get placed along
+     */
+    void set_direction(Direction direction);
+
+    /**
+     * Getter for _alignment
+     * @return this->_alignment
+     */
+    Alignment alignment() const;
+
+    /**
+     * Setter for _alignment
+     * @param alignment placement of children on the cross axis
+     */
+    void set_alignment(Alignment alignment);
+
+    /**
+     * Getter for _spacing
+     * @return this->_spacing
+     */
+    unsigned spacing() const;
+
+    /**
+     * Setter for _spacing
+     * @param spacing space between two children
+     */
+    void set_spacing(unsigned spacing);
+
+    /**
+     * Getter for _padding
+     * @return this->_padding
+     */
+    unsigned padding() const;
+
+    /**
+     * Setter for _padding
+     * @param padding space between the border and the children
+     */
+    void set_padding(unsigned padding);
+};
+}
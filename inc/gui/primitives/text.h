@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <SDL2/SDL_ttf.h>
 
@@ -9,15 +12,30 @@
 namespace SDL_GUI {
 /** primitive for rendering text */
 class Text : public Drawable {
+    /** alpha of a rendered text, computed once it gets drawn directly onto a surface */
+    struct Coverage {
+        std::once_flag _once;       /**< guards computing _alpha */
+        std::vector<Uint8> _alpha;  /**< alpha of every pixel, row after row */
+    };
+
 protected:
-    std::vector<SDL_Surface *>_surfaces;    /**< SDL surfaces to put text on */
-    SDL_Surface *_surface = nullptr;
+    /** surface with all lines of text. Copies share it, as it never changes once rendered. */
+    std::shared_ptr<SDL_Surface> _surface;
+    /** coverage of _surface. Shared like _surface. */
+    std::shared_ptr<Coverage> _coverage;
     TTF_Font *_font;                        /**< Font to use */
     std::string _text;                      /**< text to display */
 
     /** apply the current style and render the text to the surface */
     void create_surfaces();
 
+    /**
+     * get the alpha of _surface. It gets computed on first use, as only drawing onto software
+     * targets needs it. This may be called from multiple threads.
+     * @return alpha of every pixel, row after row
+     */
+    const std::vector<Uint8> &coverage() const;
+
     Drawable *clone() const override;
 public:
     /**
@@ -28,9 +46,6 @@ public:
      */
     Text(TTF_Font *font, const std::string text = "", Position position = {0, 0});
 
-    /** Destructor */
-    ~Text();
-
     void draw(SDL_Renderer *renderer, Position position) const override;
 
     unsigned width() const override;
@@ -3,19 +3,24 @@
 #include <string>
 
 #include "../drawable.h"
+#include "../texture_cache.h"
 
 namespace SDL_GUI {
-/** primitive for rendering a texture */
+/**
+ * primitive for rendering a texture
+ * Images get decoded on worker threads once they get drawn. The upload to the GPU happens on the
+ * render thread in upload_decoded(). Until then a placeholder gets drawn. The image is drawn from
+ * a downscaled variant that matches the drawn size.
+ */
 class Texture : public Drawable {
-    std::string _path;      /**< path to texture file */
-    SDL_Texture *_texture;  /**< actual texture object */
+    std::string _path;              /**< path to texture file */
+    SDL_Renderer *_renderer;        /**< renderer the texture got created for */
+    TextureCache *_cache;           /**< cache of _renderer */
+    TextureEntry *_entry;           /**< shared state of the image */
     virtual Drawable *clone() const override;
 protected:
     Texture(std::string type, std::string path, SDL_Renderer *renderer);
 public:
-    /** mapping from paths to already existent textures */
-    static std::map<std::string, SDL_Texture *> _textures;
-
     /**
      * Constructor
      * @param path path to texture file
@@ -24,6 +29,29 @@ public:
     Texture(std::string path, SDL_Renderer *renderer)
         : Texture("Texture", path, renderer) {}
 
+    /**
+     * Copy constructor. The copy references the same image.
+     * @param texture texture to copy
+     */
+    Texture(const Texture &texture);
+
+    /** Destructor */
+    ~Texture();
+
     void draw(SDL_Renderer *renderer, Position position) const override;
+
+    /**
+     * upload images that finished decoding. This has to be called on the render thread.
+     * @param renderer the renderer to upload for
+     * @param budget maximum number of bytes to upload. At least one image gets uploaded.
+     * @return whether any image got uploaded
+     */
+    static bool upload_decoded(SDL_Renderer *renderer, size_t budget = 4 * 1024 * 1024);
+
+    /**
+     * destroy all loaded textures and atlas pages of a renderer
+     * @param renderer the renderer
+     */
+    static void destroy_textures(SDL_Renderer *renderer);
 };
 }
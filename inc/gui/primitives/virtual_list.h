@@ -0,0 +1,140 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "rect.h"
+
+namespace SDL_GUI {
+/**
+ * Scrollable list of rows of which only the visible ones exist as drawables.
+ * The rows are stacked vertically, the content is as high as all rows together and the scroll
+ * limits get derived from that. Only rows inside the list, plus a few above and below, get
+ * instantiated. Rows that leave that range get hidden and reused for rows that enter it, so memory
+ * and the time to build the list do not depend on the number of rows.
+ * Copies of a list are plain rects with copies of the rows instantiated at the time of copying.
+ */
+class VirtualList : public Rect {
+public:
+    /** function that creates an unbound row drawable */
+    using RowFactory = std::function<Drawable *()>;
+
+    /** function that changes a row drawable to display a given row */
+    using RowBinder = std::function<void (Drawable *, size_t)>;
+
+    /** function that returns the height of a given row */
+    using RowHeightProvider = std::function<unsigned (size_t)>;
+
+private:
+    size_t _row_count;                          /**< number of rows */
+    unsigned _row_height;                       /**< height of all rows. 0 if they differ */
+    RowHeightProvider _row_height_provider;     /**< heights of rows if they differ */
+    std::vector<unsigned long> _row_offsets;    /**< offsets of rows if they differ, and total */
+    unsigned _overscan;                         /**< rows to keep instantiated above and below */
+    RowFactory _create_row;                     /**< creates row drawables */
+    RowBinder _bind_row;                        /**< binds row drawables to rows */
+
+    std::map<size_t, Drawable *> _visible_rows; /**< instantiated rows by row index */
+    std::vector<Drawable *> _free_rows;         /**< hidden row drawables to reuse */
+
+    /** recompute the row offsets after row count or heights changed */
+    void update_row_offsets();
+
+    /** derive the scroll limits from the heights of content and list */
+    void update_scroll_limits();
+
+    /**
+     * get the row at a vertical offset in the content
+     * @param offset vertical offset in the content
+     * @return index of row. _row_count if the offset is below the last row.
+     */
+    size_t row_at(unsigned long offset) const;
+
+    /**
+     * bind row drawables to the rows in and around the visible area
+     * @param rebind flag that determines whether instantiated rows get bound again
+     */
+    void update_rows(bool rebind = false);
+
+protected:
+    Drawable *clone() const override;
+
+    /** @copydoc Drawable::hook_post_scroll(Position) */
+    void hook_post_scroll(Position scroll_offset) override;
+
+    /** @copydoc Drawable::hook_post_resize(unsigned, unsigned) */
+    void hook_post_resize(unsigned width, unsigned height) override;
+
+public:
+    /**
+     * Constructor for rows of equal height
+     * @param position local position inside parent drawable
+     * @param width width of list
+     * @param height height of list
+     * @param row_count number of rows
+     * @param row_height height of every row
+     * @param create_row function that creates an unbound row drawable
+     * @param bind_row function that changes a row drawable to display a given row
+     * @param overscan rows to keep instantiated above and below the visible ones
+     */
+    VirtualList(Position position, unsigned width, unsigned height, size_t row_count,
+                unsigned row_height, RowFactory create_row, RowBinder bind_row,
+                unsigned overscan = 4);
+
+    /**
+     * Constructor for rows of differing height
+     * @param position local position inside parent drawable
+     * @param width width of list
+     * @param height height of list
+     * @param row_count number of rows
+     * @param row_height_provider function that returns the height of a given row
+     * @param create_row function that creates an unbound row drawable
+     * @param bind_row function that changes a row drawable to display a given row
+     * @param overscan rows to keep instantiated above and below the visible ones
+     */
+    VirtualList(Position position, unsigned width, unsigned height, size_t row_count,
+                RowHeightProvider row_height_provider, RowFactory create_row, RowBinder bind_row,
+                unsigned overscan = 4);
+
+    /**
+     * Getter for _row_count
+     * @return this->_row_count
+     */
+    size_t row_count() const;
+
+    /**
+     * change the number of rows. All instantiated rows get bound again.
+     * @param row_count number of rows
+     */
+    void set_row_count(size_t row_count);
+
+    /**
+     * get the height of all rows together
+     * @return height of content
+     */
+    unsigned long content_height() const;
+
+    /**
+     * get the vertical offset of a row in the content
+     * @param row index of row
+     * @return offset of row
+     */
+    unsigned long row_offset(size_t row) const;
+
+    /**
+     * get the number of instantiated row drawables, including hidden ones
+     * @return number of row drawables
+     */
+    size_t instantiated_rows() const;
+
+    /** bind all instantiated rows again, e.g. after the displayed data changed */
+    void refresh();
+
+    /**
+     * scroll so that a given row is at the top of the list, as far as the limits allow
+     * @param row index of row
+     */
+    void scroll_to(size_t row);
+};
+}
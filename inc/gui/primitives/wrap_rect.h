@@ -4,14 +4,21 @@
 
 namespace SDL_GUI {
 
+/** rect that grows and shrinks to the bounding box of its children */
 class WrapRect : public Rect {
     WrapRect(std::string type, Position position = {0,0})
         : Rect(type, position) {}
 
+protected:
+    /** @copydoc Drawable::hook_post_child_change(Drawable *) */
+    void hook_post_child_change(Drawable *child) override;
+
+    /** @copydoc Drawable::layout() */
+    void layout() override;
+
 public:
     WrapRect(Position position = {0, 0})
         : WrapRect("WrapRect", position) {}
-    virtual void update();
 };
 
 }
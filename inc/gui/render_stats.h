@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+
+namespace SDL_GUI {
+/**
+ * Counters collected while rendering a single frame
+ * The counters are atomic, as tiles of a frame may get rendered on multiple threads.
+ */
+class RenderStats {
+public:
+    unsigned long _frame = 0;                           /**< number of the frame these counters belong to */
+    std::atomic<unsigned long> _drawn = 0;              /**< number of drawables that got drawn */
+    std::atomic<unsigned long> _culled = 0;             /**< number of drawables outside of their parents clip rect */
+    std::atomic<unsigned long> _culled_subtrees = 0;    /**< number of subtrees that got skipped without visiting them */
+    std::atomic<unsigned long> _occluded = 0;           /**< number of drawables hidden beneath opaque drawables */
+    std::atomic<unsigned long> _pixels_drawn = 0;       /**< number of pixels covered by drawn drawables */
+    std::atomic<unsigned long> _pixels_occluded = 0;    /**< number of pixels not drawn because of occlusion */
+
+    /**
+     * Constructor
+     * @param frame number of the frame these counters belong to
+     */
+    RenderStats(unsigned long frame = 0) : _frame(frame) {}
+
+    /**
+     * reset all counters for a new frame
+     * @param frame number of the new frame
+     */
+    void reset(unsigned long frame) {
+        this->_frame = frame;
+        this->_drawn = 0;
+        this->_culled = 0;
+        this->_culled_subtrees = 0;
+        this->_occluded = 0;
+        this->_pixels_drawn = 0;
+        this->_pixels_occluded = 0;
+    }
+
+    /**
+     * add the counters of another frame to these
+     * @param stats counters to add
+     */
+    void add(const RenderStats &stats) {
+        this->_drawn += stats._drawn;
+        this->_culled += stats._culled;
+        this->_culled_subtrees += stats._culled_subtrees;
+        this->_occluded += stats._occluded;
+        this->_pixels_drawn += stats._pixels_drawn;
+        this->_pixels_occluded += stats._pixels_occluded;
+    }
+
+    /**
+     * get the number of geometry store entries the frame read. Every visited drawable reads its
+     * own entry, which fills one cache line. Drawables in skipped subtrees are not visited.
+     * @return number of entries
+     */
+    unsigned long geometry_entries() const {
+        return this->_drawn + this->_culled + this->_occluded;
+    }
+};
+}
@@ -8,11 +8,14 @@
 namespace SDL_GUI {
 /**
  * Abstract class for objects that can be scrolled.
+ * Scrolling does not change the positions of childs. The scroll position gets applied as offset
+ * when their absolute positions get resolved and when they get rendered, so a scroll step takes
+ * the same time regardless of the number of childs.
  * TODO: This should have some kind of bounds checking on the actual scrolling.
  */
 class Scrollable: public Positionable {
 protected:
-    Position _scroll_position;  /**< current offset from the original position */
+    Position _scroll_position;  /**< current offset of all childs from their positions */
 
     /** flag describing whether scrolling on x axis is enabled */
     bool _scrolling_x_enabled = false;
@@ -35,7 +38,16 @@ protected:
      * @param scroll_offset scrolling that happened
      */
     virtual void hook_post_scroll(Position scroll_offset) {(void)scroll_offset;};
+
+    /** hook to execute after enabling or disabling scrolling in any direction */
+    virtual void hook_post_toggle_scrolling() {}
 public:
+    /**
+     * check whether the childs may be shifted by scrolling
+     * @return True if scrolling is enabled or the scroll position is not zero. False otherwise.
+     */
+    bool is_scroll_container() const;
+
     /**
      * Getter for _scroll_position
      * @return  this->_scroll_position
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+namespace SDL_GUI {
+/** rectangular part of a texture */
+struct TextureRegion {
+    SDL_Texture *_texture = nullptr;    /**< texture that holds the image */
+    SDL_Rect _rect = {0, 0, 0, 0};      /**< area of the image inside of _texture */
+    bool _is_atlas_page = false;        /**< flag that determines whether _texture is shared */
+    SDL_Surface *_surface = nullptr;    /**< image in system memory instead of _texture */
+};
+
+/**
+ * Shared texture pages that small images get packed into. Drawing images from the same page one
+ * after another does not switch textures, so SDL can batch those draws.
+ * Images are packed into rows (shelves) of similar height. The space of a removed image is not
+ * reused, but a page gets destroyed once all of its images got removed.
+ */
+class TextureAtlas {
+    /** row of images inside of a page */
+    struct Shelf {
+        int _y;         /**< top of shelf */
+        int _height;    /**< height of shelf */
+        int _x;         /**< left of the free space in this shelf */
+    };
+
+    /** single texture images get packed into */
+    struct Page {
+        SDL_Texture *_texture = nullptr;    /**< the pages texture */
+        std::vector<Shelf> _shelves;        /**< rows of images */
+        int _y = 0;                         /**< top of the free space below all shelves */
+        unsigned _images = 0;               /**< number of images living in this page */
+    };
+
+    int _page_size;                 /**< width and height of a page */
+    int _max_image_size;            /**< maximum width and height of images to pack */
+    std::vector<Page> _pages;       /**< all pages */
+
+    /**
+     * find space for an image of a given size in a page
+     * @param page page to search in
+     * @param width width of image
+     * @param height height of image
+     * @param[out] rect area inside of the page
+     * @return True if there was enough space. False otherwise.
+     */
+    bool allocate(Page *page, int width, int height, SDL_Rect *rect) const;
+
+public:
+    /**
+     * Constructor
+     * @param page_size width and height of a page
+     * @param max_image_size maximum width and height of images to pack
+     */
+    TextureAtlas(int page_size = 1024, int max_image_size = 128);
+
+    /**
+     * check if an image is small enough to get packed
+     * @param surface image
+     * @return True if image can be packed. False otherwise.
+     */
+    bool fits(const SDL_Surface *surface) const;
+
+    /**
+     * copy an image into one of the pages. A new page gets created if there is no space left.
+     * @param renderer the applications renderer
+     * @param surface image to pack
+     * @return region of the image. Its texture is nullptr if packing failed.
+     */
+    TextureRegion insert(SDL_Renderer *renderer, SDL_Surface *surface);
+
+    /**
+     * remove an image from its page. The page gets destroyed if no image lives in it anymore.
+     * @param region region returned by insert()
+     */
+    void remove(const TextureRegion &region);
+
+    /** destroy all pages */
+    void clear();
+
+    /**
+     * get the number of pages
+     * @return number of pages
+     */
+    size_t page_count() const;
+
+    /**
+     * get the number of bytes of all pages in video memory
+     * @return number of bytes
+     */
+    size_t bytes() const;
+};
+}
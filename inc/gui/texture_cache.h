@@ -0,0 +1,307 @@
+#pragma once
+
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <SDL2/SDL.h>
+
+#include "asset_pack.h"
+#include "texture_atlas.h"
+#include "../util/thread_pool.h"
+
+namespace SDL_GUI {
+/** one resolution of an image. Level n has the size of the original image divided by 2^n. */
+struct TextureLevel {
+    TextureRegion _region;          /**< texture and area of the level inside of it */
+    bool _is_loading = true;        /**< flag that determines whether the level is not yet uploaded */
+    size_t _bytes = 0;              /**< estimated number of bytes of the levels pixels */
+    unsigned long _used_frame = 0;  /**< frame the level got drawn last */
+};
+
+/** image shared by all Texture drawables with the same path */
+struct TextureEntry {
+    std::string _path;                      /**< path to image file */
+    std::map<unsigned, TextureLevel> _levels;   /**< mapping from levels to loaded resolutions */
+    int _width = 0;                         /**< width of original image. 0 until decoded once */
+    int _height = 0;                        /**< height of original image. 0 until decoded once */
+    bool _is_decoding = false;              /**< flag that determines whether the first decode runs */
+    bool _is_failed = false;                /**< flag that determines whether the image is unreadable */
+    unsigned _references = 0;               /**< number of drawables using this image */
+    size_t _bytes = 0;                      /**< estimated number of bytes of all levels */
+    std::list<std::string>::iterator _lru_position; /**< position in _unused if unreferenced */
+};
+
+/**
+ * Images used by Texture drawables, identified by their path.
+ * Images get decoded and downscaled on worker threads and uploaded on the render thread. Images
+ * contained in the asset pack skip decoding and get uploaded straight from its mapping. Each
+ * drawable gets the smallest power of two downscaled level that is at least as large as the drawn
+ * size, so thumbnails do not keep the original image resident. Levels that were not drawn for a
+ * while get dropped, as long as another level of the image remains.
+ * Every entry counts the drawables referencing it. Unreferenced entries are kept for reuse until
+ * the estimated size of all textures exceeds the budget. Then the least recently released ones get
+ * evicted. Atlas pages count with their full size, as they only get freed once all images in them
+ * got evicted.
+ * Textures can only be used with the renderer that created them, so there is one cache per
+ * renderer. Software renderers drawing onto the same surface from multiple threads can share a
+ * surface cache instead, which keeps the images as ARGB8888 surfaces that get blended directly.
+ */
+class TextureCache {
+    /** image decoded by a worker thread that waits for its upload */
+    struct Decoded {
+        std::string _path;          /**< path to image file */
+        unsigned _level;            /**< level of the decoded image */
+        SDL_Surface *_surface;      /**< decoded image. nullptr if decoding failed */
+        int _width;                 /**< width of original image */
+        int _height;                /**< height of original image */
+    };
+
+    /** mapping from renderers to their caches */
+    static std::map<SDL_Renderer *, TextureCache *> _caches;
+
+    /** mutex guarding _caches */
+    static std::mutex _caches_mutex;
+
+    /** number of frames a level may stay unused before it gets dropped */
+    static const unsigned long UNUSED_LEVEL_FRAMES = 120;
+
+    /** maximum number of downscale levels */
+    static const unsigned MAX_LEVEL = 16;
+
+    /* images get acquired and released on the thread that updates the drawable tree while the
+     * render thread draws them */
+    mutable std::mutex _mutex;          /**< mutex guarding the images and statistics */
+    std::map<std::string, TextureEntry> _entries;   /**< mapping from paths to images */
+    std::list<std::string> _unused;     /**< unreferenced paths, most recently released first */
+    TextureAtlas _atlas;                /**< atlas small images get packed into */
+    AssetPack _asset_pack;              /**< pre-decoded images */
+    ThreadPool *_decoder_pool = nullptr;    /**< worker threads that decode images */
+
+    std::deque<Decoded> _decoded;       /**< decoded images waiting for their upload */
+    std::mutex _decoded_mutex;          /**< mutex guarding _decoded */
+
+    bool _is_surface_cache;             /**< flag that determines whether images are surfaces */
+    size_t _budget;                     /**< maximum number of bytes for all images */
+    size_t _bytes = 0;                  /**< number of bytes of all textures and atlas pages */
+    unsigned long _frame = 0;           /**< number of the current frame */
+    unsigned _pending = 0;              /**< number of decodes that are not yet uploaded */
+    unsigned long _hits = 0;            /**< number of acquires of already known images */
+    unsigned long _misses = 0;          /**< number of acquires that had to load the image */
+    unsigned long _evictions = 0;       /**< number of evicted images */
+
+    /**
+     * destroy an image and remove it from the cache
+     * @param it iterator pointing to the image
+     */
+    void destroy(std::map<std::string, TextureEntry>::iterator it);
+
+    /**
+     * destroy a single level of an image
+     * @param entry image the level belongs to
+     * @param it iterator pointing to the level
+     */
+    void destroy_level(TextureEntry &entry, std::map<unsigned, TextureLevel>::iterator it);
+
+    /** evict least recently released images until the budget is met */
+    void evict();
+
+    /** drop levels that were not drawn for UNUSED_LEVEL_FRAMES */
+    void trim_levels();
+
+    /**
+     * decode an image on a worker thread
+     * @param path path to image file
+     * @param level level to produce. MAX_LEVEL + 1 to choose it by the target size.
+     * @param width target width if the level is chosen by size
+     * @param height target height if the level is chosen by size
+     */
+    void decode(std::string path, unsigned level, int width, int height);
+
+    /**
+     * upload a decoded image. Small images get packed into the atlas. Surface caches keep a copy
+     * of the image instead.
+     * @param surface decoded image
+     * @param renderer renderer to create the texture with
+     * @return region of the uploaded image
+     */
+    TextureRegion upload(SDL_Surface *surface, SDL_Renderer *renderer);
+
+    /**
+     * upload a decoded image as level of an entry
+     * @param entry image the level belongs to
+     * @param index level of the decoded image
+     * @param surface decoded image
+     * @param renderer renderer to create the texture with
+     * @return number of uploaded bytes. 0 if the upload failed, which marks the entry as failed.
+     */
+    size_t store(TextureEntry &entry, unsigned index, SDL_Surface *surface,
+                 SDL_Renderer *renderer);
+
+    /**
+     * get an image of the asset pack as surface
+     * @param image image inside of the asset pack
+     * @return surface referencing the mapped pixels
+     */
+    static SDL_Surface *surface_of(const AssetPackImage *image);
+
+    /**
+     * get the level of an image to draw it in a given size
+     * @param width width of original image
+     * @param height height of original image
+     * @param target_width drawn width
+     * @param target_height drawn height
+     * @return smallest level that is at least as large as the drawn size
+     */
+    static unsigned level_for(int width, int height, int target_width, int target_height);
+
+    /**
+     * halve an image per level with a box filter
+     * @param surface image to scale. This gets freed.
+     * @param level number of times to halve the image
+     * @return downscaled image
+     */
+    static SDL_Surface *downscale(SDL_Surface *surface, unsigned level);
+public:
+    /**
+     * Constructor
+     * @param budget maximum number of bytes for all images
+     * @param is_surface_cache flag that determines whether images are kept as surfaces
+     */
+    TextureCache(size_t budget = 256 * 1024 * 1024, bool is_surface_cache = false);
+
+    /** Destructor. Waits for running decodes. */
+    ~TextureCache();
+
+    /**
+     * get the cache of a renderer. It gets created if it does not exist.
+     * @param renderer the renderer
+     * @return cache of renderer
+     */
+    static TextureCache *of(SDL_Renderer *renderer);
+
+    /**
+     * destroy the cache of a renderer with all its textures. This has to be called before the
+     * renderer gets destroyed.
+     * @param renderer the renderer
+     */
+    static void destroy(SDL_Renderer *renderer);
+
+    /**
+     * use an existing cache for a renderer instead of creating one. The cache is not owned by the
+     * renderer and has to be removed with unshare() before it gets destroyed.
+     * @param renderer the renderer
+     * @param cache surface cache to use for renderer
+     */
+    static void share(SDL_Renderer *renderer, TextureCache *cache);
+
+    /**
+     * remove the cache of a renderer without destroying it
+     * @param renderer the renderer
+     */
+    static void unshare(SDL_Renderer *renderer);
+
+    /**
+     * get the image for a path and add a reference to it
+     * @param path path to image file
+     * @return image. The address stays valid until the last reference gets released.
+     */
+    TextureEntry *acquire(std::string path);
+
+    /**
+     * get the image for a path without adding a reference to it. The image counts as most
+     * recently released. The returned address is only valid until the next eviction.
+     * @param path path to image file
+     * @return image
+     */
+    TextureEntry *lookup(std::string path);
+
+    /**
+     * remove a reference to an image. Unreferenced images may get evicted with the next upload,
+     * so no textures get destroyed outside of the render thread.
+     * @param path path to image file
+     */
+    void release(std::string path);
+
+    /**
+     * map an asset pack. Images in it are used instead of decoding their files.
+     * @param path path to pack file
+     * @return whether the pack is valid
+     */
+    bool load_asset_pack(std::string path);
+
+    /**
+     * get the texture to draw an image in a given size. Missing levels start decoding.
+     * @param renderer renderer to create the textures with
+     * @param entry image to draw
+     * @param width drawn width
+     * @param height drawn height
+     * @return best uploaded level. nullptr if no level is uploaded yet.
+     */
+    const TextureRegion *find(SDL_Renderer *renderer, TextureEntry *entry, int width,
+                              int height);
+
+    /**
+     * upload images that finished decoding and drop unused levels. This has to be called once per
+     * frame on the render thread.
+     * @param renderer renderer to create the textures with
+     * @param budget maximum number of bytes to upload. At least one image gets uploaded.
+     * @return whether any image got uploaded
+     */
+    bool upload_decoded(SDL_Renderer *renderer, size_t budget);
+
+    /** destroy all images and atlas pages */
+    void clear();
+
+    /**
+     * check whether images are still decoding
+     * @return whether any decode is not yet uploaded
+     */
+    bool is_loading() const;
+
+    /**
+     * Getter for _bytes
+     * @return this->_bytes
+     */
+    size_t bytes() const;
+
+    /**
+     * Getter for _budget
+     * @return this->_budget
+     */
+    size_t budget() const;
+
+    /**
+     * Setter for _budget
+     * This evicts unreferenced images if the new budget is exceeded.
+     * @param budget maximum number of bytes for all images
+     */
+    void set_budget(size_t budget);
+
+    /**
+     * get the number of known images
+     * @return number of images
+     */
+    size_t size() const;
+
+    /**
+     * Getter for _hits
+     * @return this->_hits
+     */
+    unsigned long hits() const;
+
+    /**
+     * Getter for _misses
+     * @return this->_misses
+     */
+    unsigned long misses() const;
+
+    /**
+     * Getter for _evictions
+     * @return this->_evictions
+     */
+    unsigned long evictions() const;
+};
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "drawable.h"
+#include "rgb.h"
+#include "texture_cache.h"
+#include "../util/thread_pool.h"
+
+namespace SDL_GUI {
+/**
+ * Renders a drawable tree to a surface on multiple threads.
+ * The surface is split into square tiles. Every worker thread has its own software renderer on
+ * the whole surface and renders the tiles it takes with the tile as clip rect, so only the
+ * drawables intersecting the tile get drawn and the tiles never write to the same pixels.
+ * All worker renderers share one surface cache for images, so every image gets decoded once
+ * instead of once per worker.
+ * Caching layers and debug information are not supported while rendering tiles.
+ */
+class TiledRenderer {
+    /** renderer of a single worker thread */
+    struct Worker {
+        SDL_Surface *_surface;      /**< surface sharing the pixels of the target */
+        SDL_Renderer *_renderer;    /**< software renderer on _surface */
+    };
+
+    SDL_Surface *_target;           /**< surface to render to */
+    int _tile_size;                 /**< width and height of tiles */
+    std::vector<Worker> _workers;   /**< renderers of the worker threads */
+    TextureCache _texture_cache;    /**< images shared by all worker renderers */
+    ThreadPool _pool;               /**< worker threads */
+
+    /**
+     * render tiles until none is left
+     * @param worker renderer to use
+     * @param root root of drawable tree
+     * @param tiles all tiles of the frame
+     * @param next index of next tile to render
+     * @param background color to clear tiles with
+     */
+    static void render_tiles(const Worker &worker, const Drawable *root,
+                             const std::vector<SDL_Rect> &tiles, std::atomic<size_t> *next,
+                             RGB background);
+public:
+    /**
+     * Constructor
+     * @param target surface to render to. Its pixels must not move while this exists.
+     * @param threads number of worker threads. 0 for the number of hardware threads.
+     * @param tile_size width and height of tiles
+     */
+    TiledRenderer(SDL_Surface *target, unsigned threads = 0, int tile_size = 128);
+
+    /** Destructor */
+    ~TiledRenderer();
+
+    TiledRenderer(const TiledRenderer &) = delete;
+    TiledRenderer &operator=(const TiledRenderer &) = delete;
+
+    /**
+     * render a drawable tree to the target
+     * @param root root of drawable tree
+     * @param clip_rect area of the target to render
+     * @param background color to clear the area with
+     */
+    void render(const Drawable *root, SDL_Rect clip_rect, RGB background);
+
+    /**
+     * get the number of worker threads
+     * @return number of worker threads
+     */
+    unsigned threads() const;
+
+    /**
+     * check whether images drawn by the workers are still decoding
+     * @return whether any decode is not yet uploaded
+     */
+    bool is_loading() const;
+};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "../util/handle_table.h"
+
+namespace SDL_GUI {
+class Drawable;
+/**
+ * Batch of changes to drawable trees.
+ * Every change to a drawable normally updates derived state right away: the geometry generation
+ * gets incremented, the cached layers of all parents get invalidated and added children get their
+ * debug information. While a transaction is open on the current thread these updates only get
+ * recorded and are done once on commit, so large subtrees get populated without repeating them
+ * for every single change. Absolute positions, clip rects and layers of changed drawables are
+ * outdated until then.
+ * Transactions are bound to the thread that opens them and may be nested. Nested transactions
+ * hand their records to the enclosing one, which commits all of them.
+ */
+class TreeTransaction {
+    /** innermost open transaction of this thread */
+    static thread_local TreeTransaction *_current;
+
+    TreeTransaction *_outer;                /**< enclosing transaction. nullptr if outermost */
+    bool _committed = false;                /**< flag that determines whether this got committed */
+    bool _geometry_changed = false;         /**< flag that determines whether geometry changed */
+    std::set<Handle> _invalidated;          /**< drawables whose layers are outdated */
+    std::vector<Handle> _debug_information; /**< drawables whose debug information is missing */
+
+public:
+    /** Constructor. This opens the transaction on the current thread. */
+    TreeTransaction();
+
+    /** Destructor. This commits the transaction unless that happened already. */
+    ~TreeTransaction();
+
+    TreeTransaction(const TreeTransaction &) = delete;
+    TreeTransaction &operator=(const TreeTransaction &) = delete;
+
+    /**
+     * get the innermost open transaction of the current thread
+     * @return open transaction. nullptr if there is none.
+     */
+    static TreeTransaction *current();
+
+    /** record that geometry of any drawable changed */
+    void defer_geometry();
+
+    /**
+     * record that the layers of a drawable and its parents are outdated
+     * @param drawable changed drawable
+     */
+    void defer_invalidate(const Drawable *drawable);
+
+    /**
+     * record that the debug information of a drawable has to be initialised
+     * @param drawable drawable without debug information
+     */
+    void defer_debug_information(const Drawable *drawable);
+
+    /**
+     * close the transaction and apply all recorded updates. Drawables that got deleted in the
+     * meantime are skipped.
+     */
+    void commit();
+};
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <SDL2/SDL.h>
+
 /**
  * @file
  * useful utilities
@@ -17,4 +19,35 @@ namespace util {
  * @param[out] b b value in RGB
  */
 void HSV_to_RGB(float h, float s, float v, float *r, float *g, float *b);
+
+/**
+ * draw a filled polygon. Unlike filledPolygonRGBA this does not use a global buffer and can be
+ * called from multiple threads with different renderers.
+ * @param renderer renderer to draw with
+ * @param xs x coordinates of points
+ * @param ys y coordinates of points
+ * @param n number of points
+ * @param r red
+ * @param g green
+ * @param b blue
+ * @param a alpha
+ */
+void filled_polygon_RGBA(SDL_Renderer *renderer, const Sint16 *xs, const Sint16 *ys, int n,
+                         Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+/**
+ * draw a thick line like thickLineRGBA, but thread safe like filled_polygon_RGBA
+ * @param renderer renderer to draw with
+ * @param x1 x coordinate of begin
+ * @param y1 y coordinate of begin
+ * @param x2 x coordinate of end
+ * @param y2 y coordinate of end
+ * @param width width of line
+ * @param r red
+ * @param g green
+ * @param b blue
+ * @param a alpha
+ */
+void thick_line_RGBA(SDL_Renderer *renderer, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2,
+                     Uint8 width, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 }}
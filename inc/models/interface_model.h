@@ -4,38 +4,62 @@
 
 #include "model_base.h"
 #include "../gui/drawable.h"
+#include "../gui/layer_cache.h"
+#include "../gui/mutation_queue.h"
+#include "../gui/render_stats.h"
+#include "../util/thread_pool.h"
 
 namespace SDL_GUI {
 /** Model for all the Data related to the grafical interface that actually gets rendered */
 class InterfaceModel : public ModelBase {
 protected:
-    static TTF_Font *_font;     /**< Font to use for text */
+    TTF_Font *_font;            /**< Font to use for text */
+    bool _owns_font;            /**< flag that determines whether _font gets closed on destruction */
     Drawable *_drawable_root;   /**< Tree of Drawables that get rendered */
     SDL_Renderer *_renderer;    /**< The applications renderer */
     unsigned _window_width;     /**< applications windows width */
     unsigned _window_height;    /**< applications windows height */
     Drawable *_null_drawable;   /**< drawable tombstone */
+    LayerCache *_layer_cache;   /**< offscreen layers of cached drawables */
+    RenderStats *_render_stats; /**< counters of the last rendered frame */
+    MutationQueue *_mutation_queue; /**< changes to the tree queued by other threads */
+    ThreadPool *_reclaimer;     /**< thread that deletes removed subtrees */
 
     /** flag that demetermines whether position and attributes position of drawables will be
      * shown */
     bool _debug_information_drawn = false;
+
+    /** flag that determines whether drawables hidden beneath opaque drawables get skipped */
+    bool _occlusion_culling = false;
+
+    /** flag that determines whether removed subtrees get deleted on a background thread */
+    bool _background_reclaim = true;
 public:
     /**
      * Constructor
      * @param renderer The applications renderer
      * @param window_width The applications windows width
      * @param window_height The applications windows height
+     * @param font Font to use for text. nullptr to open the systems default font.
      */
-    InterfaceModel(SDL_Renderer *renderer, unsigned window_width, unsigned window_height);
+    InterfaceModel(SDL_Renderer *renderer, unsigned window_width, unsigned window_height,
+                   TTF_Font *font = nullptr);
 
     /** Destructor */
     ~InterfaceModel();
 
+    /**
+     * open the systems default font as found by fontconfig
+     * @param size point size of font
+     * @return opened font. nullptr on failure.
+     */
+    static TTF_Font *open_default_font(int size = 12);
+
     /**
      * Getter for _font
      * @return this->_font
      */
-    static TTF_Font *font();
+    TTF_Font *font() const;
 
     /**
      * Getter for _drawable_root
@@ -56,7 +80,7 @@ public:
      * Getter for _renderer
      * @return this->_renderer
      */
-    SDL_Renderer *renderer();
+    SDL_Renderer *renderer() const;
 
     /**
      * Getter for _window_width
@@ -76,6 +100,41 @@ public:
      */
     Drawable *null_drawable() const;
 
+    /**
+     * Getter for _layer_cache
+     * @return this->_layer_cache
+     */
+    LayerCache *layer_cache() const;
+
+    /**
+     * Getter for _render_stats
+     * @return this->_render_stats
+     */
+    RenderStats *render_stats() const;
+
+    /**
+     * Getter for _mutation_queue
+     * @return this->_mutation_queue
+     */
+    MutationQueue *mutation_queue() const;
+
+    /**
+     * delete a subtree that got removed from the tree on a background thread, so removing large
+     * subtrees does not stall the caller. Layers of the subtree get destroyed on the render thread.
+     * @param subtree removed subtree
+     */
+    void reclaim(Drawable *subtree) const;
+
+    /** wait until all removed subtrees are deleted */
+    void wait_for_reclaimer() const;
+
+    /**
+     * Setter for _background_reclaim
+     * @param background_reclaim flag that determines whether removed subtrees get deleted on a
+     *   background thread instead of right away
+     */
+    void set_background_reclaim(bool background_reclaim);
+
     /**
      * Getter fot _debug_information_drawm
      * @return this->_debug_information_drawn
@@ -85,6 +144,18 @@ public:
     /** toggle this->_draw_debug_information */
     void toggle_debug_information_drawn();
 
+    /**
+     * Getter for _occlusion_culling
+     * @return this->_occlusion_culling
+     */
+    bool occlusion_culling() const;
+
+    /**
+     * Setter for _occlusion_culling
+     * @param occlusion_culling flag that determines whether occluded drawables get skipped
+     */
+    void set_occlusion_culling(bool occlusion_culling);
+
     /**
      * find all Drawables in _drawable_root with a certain attribute
      * @param attribute attribute to find
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
 #include "../application.h"
 #include "plugin_base.h"
 
@@ -9,6 +14,8 @@
 #include "../models/input_model.h"
 #include "../views/interface_view.h"
 
+#include "../gui/primitives/texture.h"
+
 #include "../config/input_config.h"
 
 namespace SDL_GUI {
@@ -19,9 +26,25 @@ private:
     ApplicationBase *_application;      /**< The application */
     InterfaceModel *_interface_model;   /**< The applications interface model */
     InputModel<InputValue, InputState> *_input_model; /**< The applications input model */
+
+    /**
+     * parse a positive count given as command line option
+     * @param value option value
+     * @param count parsed count. It stays untouched if value is no positive number.
+     * @return whether value is a positive number
+     */
+    static bool parse_count(const std::string &value, unsigned *count);
 public:
     /** Constructor */
-    Core(CommandLine *command_line) : PluginBase("Core", command_line) {}
+    Core(CommandLine *command_line) : PluginBase("Core", command_line) {
+        command_line->register_flag("occlusion-culling");
+        command_line->register_option("texture-budget");
+        command_line->register_option("asset-pack");
+        command_line->register_option("render-threads");
+        command_line->register_option("capture");
+        command_line->register_option("capture-format");
+        command_line->register_option("capture-buffers");
+    }
 
     /**
      * Create all the needed Models, Controllers and Views
@@ -36,15 +59,28 @@ public:
         (void)plugins;
         this->_application = app;
 
-        if (app->is_headless()) {
-            return;
-        }
-
         /* Models */
         this->_interface_model = new SDL_GUI::InterfaceModel(app->renderer(), app->window_width(),
                                                              app->window_height());
         app->add_model(this->_interface_model);
-        Drawable::set_interface_model(this->_interface_model);
+        this->_interface_model->set_occlusion_culling(
+            this->_command_line->get_flag("occlusion-culling"));
+        /* texture budget is given in MiB */
+        std::string texture_budget = this->_command_line->get_option("texture-budget");
+        if (not texture_budget.empty()) {
+            TextureCache *texture_cache = TextureCache::of(app->renderer());
+            unsigned budget;
+            if (Core::parse_count(texture_budget, &budget)) {
+                texture_cache->set_budget(size_t(budget) * 1024 * 1024);
+            } else {
+                std::cerr << "invalid texture budget " << texture_budget << ", keeping "
+                          << texture_cache->budget() / (1024 * 1024) << " MiB" << std::endl;
+            }
+        }
+        std::string asset_pack = this->_command_line->get_option("asset-pack");
+        if (not asset_pack.empty() and not TextureCache::of(app->renderer())->load_asset_pack(asset_pack)) {
+            std::cerr << "could not load asset pack " << asset_pack << std::endl;
+        }
 
         this->_input_model = new InputModel<InputValue, InputState>(InputState::ALL);
         app->add_model(this->_input_model);
@@ -63,6 +99,41 @@ public:
 
         /* Views */
         InterfaceView *interface_view = new InterfaceView(app->renderer(), this->_interface_model);
+        /* the update thread hands the tree over to the render thread as snapshots */
+        interface_view->set_snapshot_rendering(app->is_render_threaded());
+        /* headless frames can be rendered in tiles on multiple threads */
+        std::string render_threads = this->_command_line->get_option("render-threads");
+        if (app->is_headless() and not render_threads.empty()) {
+            /* more threads than that only add overhead to the tiles */
+            const unsigned max_threads = 256;
+            unsigned threads;
+            if (not Core::parse_count(render_threads, &threads) or threads > max_threads) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+                std::cerr << "invalid number of render threads " << render_threads << ", using "
+                          << threads << std::endl;
+            }
+            interface_view->set_tiled_renderer(new TiledRenderer(app->surface(), threads));
+        }
+        /* record every frame, e.g. as reference for visual regression tests */
+        std::string capture = this->_command_line->get_option("capture");
+        if (not capture.empty()) {
+            std::string capture_format = this->_command_line->get_option("capture-format");
+            FrameCapture::Format format = FrameCapture::Format::PNG;
+            if (not capture_format.empty()
+                and not FrameCapture::parse_format(capture_format, &format)) {
+                std::cerr << "unknown capture format " << capture_format << std::endl;
+            }
+            std::string capture_buffers = this->_command_line->get_option("capture-buffers");
+            unsigned buffers = 4;
+            if (not capture_buffers.empty() and not Core::parse_count(capture_buffers, &buffers)) {
+                std::cerr << "invalid number of capture buffers: " << capture_buffers << std::endl
+                          << "usage: --capture-buffers <count greater than 0>" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            interface_view->set_frame_capture(new FrameCapture(capture, format,
+                                                               app->window_width(),
+                                                               app->window_height(), buffers));
+        }
         app->add_view(interface_view);
     }
 
@@ -116,10 +116,6 @@ public:
     void init(ApplicationBase *app, std::tuple<Ts...> *plugins) {
         (void)app;
 
-        if (app->is_headless()) {
-            return;
-        }
-
         /* Models */
         InputModel<ExampleInputValue, ExampleInputState> *input_model =
             new InputModel<ExampleInputValue, ExampleInputState>(ExampleInputState::ALL);
@@ -143,32 +139,33 @@ public:
         /* Add content */
 
         Drawable *stats = this->_interface_model->find_first_drawable("stats");
+        const std::vector<std::string> attributes = {"fps", "tps", "loops"};
+        const std::vector<std::string> labels = {"fps:   ", "tps:   ", "loops: "};
+        const int ys[] = {0, 13, 25};
+        std::vector<Handle> lines;
+        for (unsigned i = 0; i < attributes.size(); ++i) {
+            Text *t = new Text(this->_interface_model->font(), labels[i] + "0");
+            t->set_x(5);
+            t->set_y(ys[i]);
+            t->add_attribute(attributes[i]);
+            stats->add_child(t);
+            lines.push_back(t->handle());
+        }
+        /* the lines are addressed by handle since they may get removed from the tree */
         stats->add_recalculation_callback(
-            [this, app](Drawable *d) {
-                d->remove_all_children();
-
-                std::stringstream ss;
-                ss << "fps:   " << app->current_fps();
-                Text *t = new Text(this->_interface_model->font(), ss.str());
-                t->set_x(5);
-                t->add_attribute("fps");
-                d->add_child(t);
-
-                ss.str("");
-                ss << "tps:   " << app->current_tps();
-                t = new Text(this->_interface_model->font(), ss.str());
-                t->set_x(5);
-                t->set_y(13);
-                t->add_attribute("tps");
-                d->add_child(t);
-
-                ss.str("");
-                ss << "loops: " << app->current_loops();
-                t = new Text(this->_interface_model->font(), ss.str());
-                t->set_x(5);
-                t->set_y(25);
-                t->add_attribute("loops");
-                d->add_child(t);
+            [app, labels, lines](Drawable *d) {
+                (void) d;
+                unsigned values[] = {app->current_fps(), app->current_tps(),
+                                     app->current_loops()};
+                for (unsigned i = 0; i < lines.size(); ++i) {
+                    Text *t = static_cast<Text *>(Drawable::from_handle(lines[i]));
+                    if (t == nullptr) {
+                        continue;
+                    }
+                    std::stringstream ss;
+                    ss << labels[i] << values[i];
+                    t->set_text(ss.str());
+                }
             });
 
         Drawable *image = this->_interface_model->find_first_drawable("image");
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SDL_GUI {
+/**
+ * Table of text cells stored column by column.
+ * All cells of a column share a single character buffer and are addressed by offsets into it, so a
+ * table with millions of cells needs two allocations per column instead of one per cell, and
+ * scanning a column for sorting or filtering reads contiguous memory. Cells can only be appended.
+ * A column holds at most 4 GiB of text.
+ */
+class ColumnStore {
+    /** single column */
+    struct Column {
+        std::string _name;                  /**< name of column */
+        std::string _chars;                 /**< text of all cells, one after another */
+        std::vector<uint32_t> _offsets;     /**< start of each cell in _chars, and the end */
+    };
+
+    std::vector<Column> _columns;   /**< all columns */
+    size_t _rows = 0;               /**< number of rows */
+
+public:
+    /**
+     * Constructor
+     * @param names names of columns
+     */
+    ColumnStore(std::vector<std::string> names);
+
+    /**
+     * reserve memory for a number of rows
+     * @param rows number of rows
+     * @param chars_per_cell expected average length of cells
+     */
+    void reserve(size_t rows, size_t chars_per_cell = 8);
+
+    /**
+     * append a row. Missing cells are empty, surplus cells get ignored.
+     * @param cells text of cells, one per column
+     */
+    void add_row(const std::vector<std::string> &cells);
+
+    /**
+     * get the number of columns
+     * @return number of columns
+     */
+    size_t columns() const;
+
+    /**
+     * get the number of rows
+     * @return number of rows
+     */
+    size_t rows() const;
+
+    /**
+     * get the name of a column
+     * @param column index of column
+     * @return name of column
+     */
+    const std::string &name(size_t column) const;
+
+    /**
+     * get the text of a cell. The view stays valid until the next row gets added.
+     * @param row index of row
+     * @param column index of column
+     * @return text of cell
+     */
+    std::string_view cell(size_t row, size_t column) const {
+        const Column &c = this->_columns[column];
+        return std::string_view(c._chars.data() + c._offsets[row],
+                                c._offsets[row + 1] - c._offsets[row]);
+    }
+};
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace SDL_GUI {
+/**
+ * Stable reference to an object in a HandleTable.
+ * A handle consists of a slot index and the generation of the slot at the time the handle got
+ * created. Once the object gets removed the generation of its slot changes, so old handles resolve
+ * to nullptr instead of to whatever object reuses the slot.
+ */
+class Handle {
+public:
+    uint32_t _index = 0;        /**< slot in table */
+    uint32_t _generation = 0;   /**< generation of slot. 0 for the null handle */
+
+    /**
+     * check whether this is not the null handle. This does not check whether the object still
+     * exists.
+     * @return whether this handle got created by a table
+     */
+    explicit operator bool() const {
+        return this->_generation != 0;
+    }
+
+    bool operator==(const Handle &other) const {
+        return this->_index == other._index and this->_generation == other._generation;
+    }
+
+    bool operator!=(const Handle &other) const {
+        return not (*this == other);
+    }
+
+    bool operator<(const Handle &other) const {
+        return this->_index < other._index
+               or (this->_index == other._index and this->_generation < other._generation);
+    }
+};
+
+/**
+ * Table that hands out generational handles for objects. Inserting, removing and looking up
+ * objects is O(1) and may happen from any thread.
+ * @tparam T type of referenced objects
+ */
+template <typename T>
+class HandleTable {
+    /** single entry of table */
+    struct Slot {
+        T *_object = nullptr;       /**< referenced object. nullptr if slot is free */
+        uint32_t _generation = 1;   /**< generation of current or next object */
+    };
+
+    std::vector<Slot> _slots;           /**< all slots ever used */
+    std::vector<uint32_t> _free;        /**< indices of free slots */
+    mutable std::shared_mutex _mutex;   /**< guards all members */
+
+    /**
+     * remove an object. The caller must hold _mutex exclusively.
+     * @param handle handle of object to remove
+     */
+    void erase_locked(Handle handle) {
+        if (handle._index >= this->_slots.size()) {
+            return;
+        }
+        Slot &slot = this->_slots[handle._index];
+        if (slot._generation != handle._generation or slot._object == nullptr) {
+            return;
+        }
+        slot._object = nullptr;
+        /* 0 is reserved for the null handle */
+        if (++slot._generation == 0) {
+            slot._generation = 1;
+        }
+        this->_free.push_back(handle._index);
+    }
+
+public:
+    /** Default constructor */
+    HandleTable() = default;
+
+    HandleTable(const HandleTable &) = delete;
+    HandleTable &operator=(const HandleTable &) = delete;
+
+    /**
+     * add an object
+     * @param object object to add
+     * @return handle of object
+     */
+    Handle insert(T *object) {
+        std::unique_lock<std::shared_mutex> lock(this->_mutex);
+        uint32_t index;
+        if (this->_free.empty()) {
+            index = static_cast<uint32_t>(this->_slots.size());
+            this->_slots.emplace_back();
+        } else {
+            index = this->_free.back();
+            this->_free.pop_back();
+        }
+        Slot &slot = this->_slots[index];
+        slot._object = object;
+        return {index, slot._generation};
+    }
+
+    /**
+     * remove an object. Every handle to it resolves to nullptr afterwards.
+     * @param handle handle of object to remove
+     */
+    void erase(Handle handle) {
+        std::unique_lock<std::shared_mutex> lock(this->_mutex);
+        this->erase_locked(handle);
+    }
+
+    /**
+     * remove multiple objects at once
+     * @param handles handles of objects to remove
+     */
+    void erase(const std::vector<Handle> &handles) {
+        std::unique_lock<std::shared_mutex> lock(this->_mutex);
+        for (Handle handle: handles) {
+            this->erase_locked(handle);
+        }
+    }
+
+    /**
+     * look up an object
+     * @param handle handle of object
+     * @return referenced object. nullptr if it got removed or handle is the null handle.
+     */
+    T *get(Handle handle) const {
+        std::shared_lock<std::shared_mutex> lock(this->_mutex);
+        if (handle._index >= this->_slots.size()) {
+            return nullptr;
+        }
+        const Slot &slot = this->_slots[handle._index];
+        if (slot._generation != handle._generation) {
+            return nullptr;
+        }
+        return slot._object;
+    }
+
+    /**
+     * get number of objects in table
+     * @return number of objects in table
+     */
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(this->_mutex);
+        return this->_slots.size() - this->_free.size();
+    }
+};
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace SDL_GUI {
+/**
+ * Unbounded lock-free queue for many producer threads and a single consumer thread.
+ * Producers push onto an atomic list with a single compare and swap. The consumer takes the whole
+ * list at once with a single exchange and processes it in the order it got pushed, so draining
+ * never blocks producers and producers never block each other.
+ * @tparam T type of queued values
+ */
+template <typename T>
+class MPSCQueue {
+    /** single queued value */
+    struct Node {
+        T _value;       /**< queued value */
+        Node *_next;    /**< node pushed before this one */
+    };
+
+    std::atomic<Node *> _head = nullptr;    /**< node pushed last */
+
+public:
+    /** Default constructor */
+    MPSCQueue() = default;
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    /** Destructor. Values that are still queued get destroyed. */
+    ~MPSCQueue() {
+        this->drain([](T &&){});
+    }
+
+    /**
+     * add a value. This may be called from any thread.
+     * @param value value to add
+     */
+    void push(T value) {
+        Node *node = new Node{std::move(value), this->_head.load(std::memory_order_relaxed)};
+        while (not this->_head.compare_exchange_weak(node->_next, node,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * take all values pushed so far and pass them to a function, oldest first. This must only be
+     * called from one thread at a time.
+     * @tparam F type of function
+     * @param f function to call with every value
+     * @return number of taken values
+     */
+    template <typename F>
+    unsigned drain(F f) {
+        Node *node = this->_head.exchange(nullptr, std::memory_order_acquire);
+        /* the list is newest first */
+        Node *oldest = nullptr;
+        while (node != nullptr) {
+            Node *next = node->_next;
+            node->_next = oldest;
+            oldest = node;
+            node = next;
+        }
+        unsigned count = 0;
+        while (oldest != nullptr) {
+            Node *next = oldest->_next;
+            f(std::move(oldest->_value));
+            delete oldest;
+            oldest = next;
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * check whether nothing is queued
+     * @return whether nothing is queued
+     */
+    bool empty() const {
+        return this->_head.load(std::memory_order_relaxed) == nullptr;
+    }
+};
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace SDL_GUI {
+/**
+ * Allocator for blocks of a single size.
+ * Blocks get carved out of large slabs and freed blocks are kept in a free list for reuse, so
+ * allocating and freeing is a pointer swap and objects allocated together lie next to each other
+ * in memory. Slabs are only returned on destruction of the allocator.
+ */
+class SlabAllocator {
+    /** freed block. The link lives inside the unused block itself. */
+    struct FreeBlock {
+        FreeBlock *_next;   /**< next free block */
+    };
+
+    const size_t _block_size;       /**< size of a single block in bytes */
+    const size_t _slab_size;        /**< size of a slab in bytes */
+    std::vector<char *> _slabs;     /**< all allocated slabs */
+    FreeBlock *_free = nullptr;     /**< list of freed blocks */
+    char *_next = nullptr;          /**< next never used block of the current slab */
+    char *_end = nullptr;           /**< end of the current slab */
+    size_t _used = 0;               /**< number of allocated blocks */
+    mutable std::mutex _mutex;      /**< guards all mutable members */
+
+public:
+    /**
+     * Constructor
+     * @param block_size size of a single block in bytes
+     * @param slab_size size of a slab in bytes. At least one block fits into every slab.
+     */
+    SlabAllocator(size_t block_size, size_t slab_size = 64 * 1024);
+
+    /** Destructor. Frees all slabs, even if blocks are still in use. */
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    /**
+     * allocate a block
+     * @return allocated block
+     */
+    void *allocate();
+
+    /**
+     * free a block allocated by this allocator
+     * @param block block to free
+     */
+    void deallocate(void *block);
+
+    /**
+     * Getter for _block_size
+     * @return this->_block_size
+     */
+    size_t block_size() const;
+
+    /**
+     * get number of blocks in use
+     * @return number of blocks in use
+     */
+    size_t used() const;
+
+    /**
+     * get number of bytes allocated for slabs
+     * @return number of bytes allocated for slabs
+     */
+    size_t reserved() const;
+};
+}
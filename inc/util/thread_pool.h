@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SDL_GUI {
+/** Fixed number of worker threads that execute queued tasks in order */
+class ThreadPool {
+    std::vector<std::thread> _workers;          /**< worker threads */
+    std::deque<std::function<void()>> _tasks;   /**< tasks that are not yet started */
+    std::mutex _mutex;                          /**< mutex guarding _tasks and _stopping */
+    std::condition_variable _condition;         /**< signals new tasks and stopping */
+    std::condition_variable _idle;              /**< signals that all tasks are done */
+    unsigned _active = 0;                       /**< number of running tasks */
+    bool _stopping = false;                     /**< flag that determines whether workers quit */
+
+    /** loop executed by each worker thread */
+    void work();
+public:
+    /**
+     * Constructor
+     * @param threads number of worker threads. 0 for the number of hardware threads.
+     */
+    ThreadPool(unsigned threads = 0);
+
+    /** Destructor. Waits for all queued tasks to finish. */
+    ~ThreadPool();
+
+    /**
+     * queue a task for execution on a worker thread
+     * @param task task to execute
+     */
+    void enqueue(std::function<void()> task);
+
+    /** wait until all queued tasks are done */
+    void wait();
+
+    /**
+     * get the number of worker threads
+     * @return number of worker threads
+     */
+    unsigned size() const;
+};
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <mutex>
+
 #include <SDL2/SDL.h>
 
 #include "view_base.h"
+#include "../gui/frame_capture.h"
+#include "../gui/tiled_renderer.h"
 #include "../models/interface_model.h"
 
 namespace SDL_GUI {
@@ -11,6 +15,32 @@ class InterfaceView : public ViewBase {
 protected:
     SDL_Renderer *_renderer;                    /**< SDL Renderer to render on */
     const InterfaceModel *_interface_model;     /**< The applications interface model */
+    TiledRenderer *_tiled_renderer = nullptr;   /**< renderer for tiles. nullptr to render directly */
+    FrameCapture *_frame_capture = nullptr;     /**< recorder of rendered frames. nullptr for none */
+
+    bool _is_snapshot_rendering = false;    /**< flag that determines whether snapshots get rendered */
+    std::mutex _snapshot_mutex;             /**< mutex guarding _snapshot and _snapshot_input_time */
+    Drawable *_snapshot = nullptr;          /**< latest published snapshot that is not yet rendered */
+    Uint32 _snapshot_input_time = 0;        /**< oldest input in _snapshot. 0 for none */
+    Drawable *_rendered_snapshot = nullptr; /**< snapshot that got rendered last */
+
+    Uint32 _input_time = 0;                 /**< oldest input that is not yet presented. 0 for none */
+    unsigned long _input_latency_count = 0; /**< number of presented frames that showed input */
+    unsigned long _input_latency_total = 0; /**< sum of all input to present latencies in ms */
+    Uint32 _input_latency_max = 0;          /**< maximum input to present latency in ms */
+    unsigned long _rendered_frames = 0;     /**< number of rendered frames */
+    unsigned long _geometry_entries = 0;    /**< sum of geometry store entries read by all frames */
+    unsigned long _window_pixels = 0;       /**< sum of window pixels of all frames */
+    RenderStats _render_totals;             /**< sum of render counters of all frames */
+
+    /**
+     * get the time of the oldest input event of the current tick
+     * @return SDL ticks of the oldest input. 0 if there is none.
+     */
+    static Uint32 oldest_input_time();
+
+    /** account the latency of the inputs shown by the frame that just got presented */
+    void record_input_latency();
 public:
     /**
      * Constructor
@@ -19,6 +49,31 @@ public:
      */
     InterfaceView(SDL_Renderer *renderer, const InterfaceModel *interface_model);
 
+    /** Destructor */
+    ~InterfaceView();
+
+    /**
+     * Setter for _tiled_renderer
+     * Frames get rendered in tiles on multiple threads unless debug information is drawn.
+     * @param tiled_renderer renderer for tiles on the surface of _renderer. This takes ownership.
+     */
+    void set_tiled_renderer(TiledRenderer *tiled_renderer);
+
+    /**
+     * Setter for _frame_capture
+     * Every rendered frame gets captured right before it is presented.
+     * @param frame_capture recorder of rendered frames. This takes ownership.
+     */
+    void set_frame_capture(FrameCapture *frame_capture);
+
+    /**
+     * Setter for _is_snapshot_rendering
+     * Every update then publishes a snapshot of the drawable tree and rendering draws the latest
+     * published one, so updating and rendering can run on different threads.
+     * @param is_snapshot_rendering flag that determines whether snapshots get rendered
+     */
+    void set_snapshot_rendering(bool is_snapshot_rendering);
+
     bool init() override;
     void deinit() override;
     void update() override;
@@ -1,14 +1,18 @@
 #include <application.h>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <iostream>
 #include <list>
+#include <thread>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
 #include <controllers/input_controller.h>
+#include <gui/blend.h>
+#include <gui/glyph_run_cache.h>
 #include <util/command_line.h>
 
 
@@ -19,6 +23,22 @@ inline std::chrono::high_resolution_clock::time_point t_sys() {
     return std::chrono::high_resolution_clock::now();
 }
 
+/**
+ * count the events in the last second
+ * @param times times of earlier events, oldest first
+ * @param now time of the new event
+ * @return number of events in the last second including the new one
+ */
+static unsigned count_last_second(std::list<std::chrono::high_resolution_clock::time_point> *times,
+                                  std::chrono::high_resolution_clock::time_point now) {
+    using namespace std::literals;
+    times->push_back(now);
+    while (not times->empty() and times->front() < now - 1s) {
+        times->pop_front();
+    }
+    return times->size();
+}
+
 ApplicationBase::~ApplicationBase() {
     for (ModelBase *model: this->_model_list) {
         delete model;
@@ -29,13 +49,14 @@ ApplicationBase::~ApplicationBase() {
     for (ControllerBase *controller: this->_controller_list) {
         delete controller;
     }
-    for (std::pair<std::string, SDL_Texture *> t: Texture::_textures) {
-        SDL_DestroyTexture(t.second);
-    }
+    Texture::destroy_textures(this->_renderer);
+    GlyphRunCache::collect(this->_renderer);
+    blend::unregister_target(this->_renderer);
 
     /* properly destroy renderer and window */
     SDL_DestroyRenderer(this->_renderer);
     SDL_DestroyWindow(this->_window);
+    SDL_FreeSurface(this->_surface);
 
     /* properly shut down SDL */
     TTF_Quit();
@@ -43,6 +64,8 @@ ApplicationBase::~ApplicationBase() {
 }
 
 void ApplicationBase::init_SDL() {
+    /* merge consecutive draws that use the same texture, e.g. the same atlas page */
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
     if (0 != SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
         exit(EXIT_FAILURE);
@@ -53,6 +76,17 @@ void ApplicationBase::init_SDL() {
     }
 }
 
+void ApplicationBase::init_headless_SDL() {
+    if (0 != SDL_Init(SDL_INIT_EVENTS)) {
+        std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
 SDL_Window *ApplicationBase::init_window(std::string title, unsigned width, unsigned height) {
     /* init window at {0,0} */
     SDL_Window *window = SDL_CreateWindow(title.c_str(), 0, 0, width, height, SDL_WINDOW_RESIZABLE);
@@ -75,17 +109,54 @@ SDL_Renderer *ApplicationBase::init_renderer(SDL_Window *window) {
     return renderer;
 }
 
+SDL_Renderer *ApplicationBase::init_software_renderer(SDL_Surface *surface) {
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    if (renderer == nullptr) {
+        std::cerr << "unable to create software renderer: " << SDL_GetError() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    return renderer;
+}
+
 ApplicationBase::ApplicationBase(std::string application_title, int argc, char *argv[],
                                  unsigned window_width, unsigned window_height)
     : _application_title(application_title), _window_width(window_width),
       _window_height(window_height) {
     this->_command_line.register_flag("headless", "", "headless");
+    this->_command_line.register_option("frames");
+    this->_command_line.register_flag("render-thread");
     this->_command_line.parse(argc, argv);
 
+    std::string frames = this->_command_line.get_option("frames");
+    if (not frames.empty()) {
+        const char *end = frames.data() + frames.size();
+        auto [parsed_end, error] = std::from_chars(frames.data(), end, this->_frame_limit);
+        if (error != std::errc() or parsed_end != end) {
+            std::cerr << "invalid number of frames: " << frames << std::endl
+                      << "usage: " << argv[0]
+                      << " [--headless] [--frames <count>] [--render-thread]" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    this->_is_render_threaded = this->_command_line.get_flag("render-thread");
+
     if (this->_command_line.get_flag("headless")) {
         this->_is_headless = true;
         std::cerr << std::endl << "== Running in headless mode. Press Ctrl-C to quit. =="
                   << std::endl;
+        /* render everything with the software renderer on an offscreen surface */
+        ApplicationBase::init_headless_SDL();
+        this->_surface = SDL_CreateRGBSurfaceWithFormat(0, window_width, window_height, 32,
+                                                        SDL_PIXELFORMAT_ARGB8888);
+        if (this->_surface == nullptr) {
+            std::cerr << "unable to create surface: " << SDL_GetError() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        this->_renderer = ApplicationBase::init_software_renderer(this->_surface);
+        /* draw rects and text with the blend kernels instead of the generic software renderer */
+        blend::register_target(this->_renderer, this->_surface);
         return;
     }
 
@@ -95,6 +166,11 @@ ApplicationBase::ApplicationBase(std::string application_title, int argc, char *
 }
 
 void ApplicationBase::run() {
+    if (this->_is_render_threaded) {
+        this->run_render_threaded();
+        return;
+    }
+
     using namespace std::literals;
     using duration_t = std::chrono::high_resolution_clock::duration;
     using time_point_t = std::chrono::high_resolution_clock::time_point;
@@ -102,7 +178,6 @@ void ApplicationBase::run() {
     std::list<time_point_t> frames;
     std::list<time_point_t> loops;
 
-
     const duration_t frame_interval = 1000000us / this->_target_fps;
     const duration_t tick_interval = 1000000us / this->_target_tps;
 
@@ -114,11 +189,10 @@ void ApplicationBase::run() {
     time_point_t next_frame_time = now;
     time_point_t last_loop_time = now;
 
-    time_point_t one_second_ago = now - 1s;
-
     while (this->_is_running) {
+        /* headless frames are not shown, so they get rendered as fast as possible */
         now = t_sys();
-        if (next_tick_time - now <= 1ms) {
+        if (this->_is_headless or next_tick_time - now <= 1ms) {
 
             last_tick_time = now;
             next_tick_time += tick_interval;
@@ -130,54 +204,37 @@ void ApplicationBase::run() {
 
 
             /* update tps stat */
-            ticks.push_back(last_tick_time);
-
-            one_second_ago = now - 1s;
-            while (not ticks.empty() and ticks.front() < one_second_ago) {
-                ticks.pop_front();
-            }
-            this->_current_tps = ticks.size();
+            this->_current_tps = count_last_second(&ticks, last_tick_time);
         }
 
         now = t_sys();
-        if (next_frame_time - now <= 1ms) {
+        if (this->_is_headless or next_frame_time - now <= 1ms) {
 
             last_frame_time = now;
             next_frame_time += frame_interval;
 
-            if (not this->_is_headless) {
-                /* render */
-                this->render_views();
+            /* render */
+            this->render_views();
+            this->_rendered_frames++;
+            if (this->_frame_limit != 0 and this->_rendered_frames >= this->_frame_limit) {
+                this->_is_running = false;
             }
 
             /* update fps stat */
-            frames.push_back(last_frame_time);
-
-            one_second_ago = now - 1s;
-            while (not frames.empty() and frames.front() < one_second_ago) {
-                frames.pop_front();
-            }
-            this->_current_fps = frames.size();
+            this->_current_fps = count_last_second(&frames, last_frame_time);
         }
 
         now = t_sys();
 
         /* update loop stat */
         last_loop_time = now;
-        loops.push_back(last_loop_time);
-
-        one_second_ago = now - 1s;
-        while (not loops.empty() and loops.front() < one_second_ago) {
-            loops.pop_front();
-        }
-
-        this->_current_loops = loops.size();
+        this->_current_loops = count_last_second(&loops, last_loop_time);
 
         duration_t time_until_next_tick = next_tick_time - now;
         duration_t time_until_next_frame = next_frame_time - now;
         duration_t time_until_next = std::min(time_until_next_tick, time_until_next_frame);
         int delay_ms = time_until_next / 1ms;
-        if (delay_ms >= 0) {
+        if (delay_ms >= 0 and not this->_is_headless) {
             SDL_Delay(std::max(1, delay_ms));
         }
 
@@ -185,6 +242,73 @@ void ApplicationBase::run() {
     this->deinit();
 }
 
+void ApplicationBase::run_render_threaded() {
+    using namespace std::literals;
+    using duration_t = std::chrono::high_resolution_clock::duration;
+    using time_point_t = std::chrono::high_resolution_clock::time_point;
+
+    const duration_t frame_interval = 1000000us / this->_target_fps;
+    const duration_t tick_interval = 1000000us / this->_target_tps;
+
+    std::thread update_thread([this, tick_interval](){
+            std::list<time_point_t> ticks;
+            time_point_t next_tick_time = t_sys();
+            while (this->_is_running) {
+                time_point_t now = t_sys();
+                next_tick_time += tick_interval;
+                /* skip ticks that are already over instead of catching up */
+                if (next_tick_time < now) {
+                    next_tick_time = now + tick_interval;
+                }
+
+                take_sdl_events();
+                this->update_controllers();
+                this->update_views();
+                clear_sdl_events();
+
+                this->_current_tps = count_last_second(&ticks, now);
+                /* headless frames are not shown, so they get rendered as fast as possible */
+                if (not this->_is_headless) {
+                    std::this_thread::sleep_until(next_tick_time);
+                }
+            }
+        });
+
+    std::list<time_point_t> frames;
+    std::list<time_point_t> loops;
+    time_point_t next_frame_time = t_sys();
+    while (this->_is_running) {
+        /* events can only be polled on this thread. The update thread takes them every tick. */
+        pump_sdl_events();
+
+        time_point_t now = t_sys();
+        if (this->_is_headless or next_frame_time - now <= 1ms) {
+            next_frame_time += frame_interval;
+            if (next_frame_time < now) {
+                next_frame_time = now + frame_interval;
+            }
+
+            this->render_views();
+            this->_rendered_frames++;
+            if (this->_frame_limit != 0 and this->_rendered_frames >= this->_frame_limit) {
+                this->_is_running = false;
+            }
+            this->_current_fps = count_last_second(&frames, now);
+        }
+
+        now = t_sys();
+        this->_current_loops = count_last_second(&loops, now);
+
+        /* wake up early enough to pass input on without adding a whole frame of latency */
+        int delay_ms = (next_frame_time - now) / 1ms;
+        if (not this->_is_headless) {
+            SDL_Delay(std::clamp(delay_ms, 1, 4));
+        }
+    }
+    update_thread.join();
+    this->deinit();
+}
+
 void ApplicationBase::update_controllers() {
     for (ControllerBase *controller: this->_controller_list) {
         controller->update();
@@ -211,6 +335,14 @@ SDL_Renderer *ApplicationBase::renderer() {
     return this->_renderer;
 }
 
+SDL_Surface *ApplicationBase::surface() {
+    return this->_surface;
+}
+
+unsigned long ApplicationBase::rendered_frames() const {
+    return this->_rendered_frames;
+}
+
 unsigned ApplicationBase::window_width() const {
     return this->_window_width;
 }
@@ -243,6 +375,10 @@ bool ApplicationBase::is_headless() const {
     return this->_is_headless;
 }
 
+bool ApplicationBase::is_render_threaded() const {
+    return this->_is_render_threaded;
+}
+
 CommandLine *ApplicationBase::command_line() {
     return &this->_command_line;
 }
@@ -1,9 +1,17 @@
 #include <controllers/input_controller.h>
 
+#include <mutex>
+
 using namespace SDL_GUI;
 
 static std::vector<SDL_Event> _events;
 
+/** events polled by pump_sdl_events() that are not yet taken */
+static std::vector<SDL_Event> _pumped_events;
+
+/** mutex guarding _pumped_events */
+static std::mutex _pumped_events_mutex;
+
 void SDL_GUI::read_sdl_events() {
     SDL_Event event;
     while (0 != SDL_PollEvent(&event)) {
@@ -11,6 +19,20 @@ void SDL_GUI::read_sdl_events() {
     }
 }
 
+void SDL_GUI::pump_sdl_events() {
+    SDL_Event event;
+    std::lock_guard<std::mutex> lock(_pumped_events_mutex);
+    while (0 != SDL_PollEvent(&event)) {
+        _pumped_events.push_back(event);
+    }
+}
+
+void SDL_GUI::take_sdl_events() {
+    std::lock_guard<std::mutex> lock(_pumped_events_mutex);
+    _events.insert(_events.end(), _pumped_events.begin(), _pumped_events.end());
+    _pumped_events.clear();
+}
+
 void SDL_GUI::clear_sdl_events() {
     _events.clear();
 }
@@ -1,6 +1,7 @@
 #include <controllers/interface_controller.h>
 
 #include <gui/drawable_tree_builder.h>
+#include <gui/tree_transaction.h>
 #include <util/xml_parser.h>
 
 using namespace SDL_GUI;
@@ -14,17 +15,23 @@ InterfaceController::InterfaceController(const std::string template_file_path,
 
 void InterfaceController::update() {
     Position mouse_position = this->_input_model->mouse_position();
+    /* apply changes of other threads before anything depends on the tree */
+    this->_interface_model->mutation_queue()->apply();
     this->_interface_model->drawable_root()->map([mouse_position](Drawable *drawable) {
         drawable->recalculate();
     });
     this->_interface_model->drawable_root()->map([mouse_position](Drawable *drawable) {
         drawable->update();
     });
+    /* only layouts whose children changed get recomputed */
+    this->_interface_model->drawable_root()->update_layout();
 }
 
 void InterfaceController::init() {
     /* parse template file */
     DrawableTreeBuilder builder(this->_interface_model->font());
     XmlParser<DrawableTreeBuilder, Drawable> parser(&builder);
+    /* debug information of all parsed drawables gets initialised at once */
+    TreeTransaction transaction;
     this->_interface_model->set_drawable_root(parser.parse_file(this->_template_file_path));
 }
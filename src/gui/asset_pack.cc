@@ -0,0 +1,181 @@
+#include <gui/asset_pack.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SDL_GUI;
+
+/** magic number at the start of every pack */
+static const char MAGIC[4] = {'S', 'G', 'P', 'K'};
+
+/**
+ * read a value from the mapping and advance the cursor
+ * @tparam T type of value
+ * @param cursor position to read from
+ * @param end end of the mapping
+ * @param value read value
+ * @return whether the value fit into the mapping
+ */
+template <typename T>
+static bool read_value(const char *&cursor, const char *end, T *value) {
+    if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(T))) {
+        return false;
+    }
+    std::memcpy(value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+/**
+ * write a value to a file
+ * @tparam T type of value
+ * @param file file to write to
+ * @param value value to write
+ */
+template <typename T>
+static void write_value(std::ofstream &file, T value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+AssetPack::~AssetPack() {
+    this->close();
+}
+
+bool AssetPack::open(std::string path) {
+    this->close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 or info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    /* the mapping stays valid after closing the file */
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    this->_mapping = mapping;
+    this->_size = info.st_size;
+
+    const char *begin = static_cast<const char *>(mapping);
+    const char *end = begin + this->_size;
+    const char *cursor = begin;
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    if (not read_value(cursor, end, &magic) or std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+        or not read_value(cursor, end, &version) or version != AssetPack::VERSION
+        or not read_value(cursor, end, &count)) {
+        this->close();
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t name_length;
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        if (not read_value(cursor, end, &name_length) or end - cursor < name_length) {
+            this->close();
+            return false;
+        }
+        std::string name(cursor, name_length);
+        cursor += name_length;
+        if (not read_value(cursor, end, &width) or not read_value(cursor, end, &height)
+            or not read_value(cursor, end, &offset)
+            or offset + static_cast<uint64_t>(width) * height * 4 > this->_size) {
+            this->close();
+            return false;
+        }
+        AssetPackImage image;
+        image._width = width;
+        image._height = height;
+        image._pixels = begin + offset;
+        this->_images[name] = image;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    if (this->_mapping != nullptr) {
+        munmap(this->_mapping, this->_size);
+    }
+    this->_mapping = nullptr;
+    this->_size = 0;
+    this->_images.clear();
+}
+
+const AssetPackImage *AssetPack::find(const std::string &name) const {
+    auto it = this->_images.find(name);
+    if (it == this->_images.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+size_t AssetPack::size() const {
+    return this->_images.size();
+}
+
+bool AssetPack::write(std::string path,
+                      const std::vector<std::pair<std::string, SDL_Surface *>> &images) {
+    std::vector<SDL_Surface *> converted;
+    for (const auto &[_, surface]: images) {
+        SDL_Surface *rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        if (rgba == nullptr) {
+            for (SDL_Surface *s: converted) {
+                SDL_FreeSurface(s);
+            }
+            return false;
+        }
+        converted.push_back(rgba);
+    }
+
+    /* header and index come first, the pixel data follows */
+    uint64_t offset = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+    for (const auto &[name, _]: images) {
+        offset += 3 * sizeof(uint32_t) + name.size() + sizeof(uint64_t);
+    }
+    std::vector<uint64_t> offsets;
+    for (SDL_Surface *surface: converted) {
+        offset = (offset + AssetPack::PIXEL_ALIGNMENT - 1) / AssetPack::PIXEL_ALIGNMENT
+                 * AssetPack::PIXEL_ALIGNMENT;
+        offsets.push_back(offset);
+        offset += static_cast<uint64_t>(surface->w) * surface->h * 4;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(MAGIC, sizeof(MAGIC));
+    write_value<uint32_t>(file, AssetPack::VERSION);
+    write_value<uint32_t>(file, images.size());
+    for (unsigned i = 0; i < images.size(); ++i) {
+        const std::string &name = images[i].first;
+        write_value<uint32_t>(file, name.size());
+        file.write(name.data(), name.size());
+        write_value<uint32_t>(file, converted[i]->w);
+        write_value<uint32_t>(file, converted[i]->h);
+        write_value<uint64_t>(file, offsets[i]);
+    }
+    for (unsigned i = 0; i < converted.size(); ++i) {
+        SDL_Surface *surface = converted[i];
+        while (static_cast<uint64_t>(file.tellp()) < offsets[i]) {
+            file.put(0);
+        }
+        /* rows are written without the surfaces padding */
+        for (int y = 0; y < surface->h; ++y) {
+            file.write(static_cast<const char *>(surface->pixels) + y * surface->pitch,
+                       surface->w * 4);
+        }
+        SDL_FreeSurface(surface);
+    }
+    return file.good();
+}
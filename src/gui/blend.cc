@@ -0,0 +1,577 @@
+#include <gui/blend.h>
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SDL_GUI_BLEND_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace SDL_GUI;
+
+namespace {
+/** set of kernels of one implementation */
+struct Kernels {
+    blend::Implementation _implementation;  /**< implementation of the kernels */
+    /** fill with a premultiplied color */
+    void (*_fill)(Uint32 *dst, int count, Uint32 premultiplied);
+    /** source over blit */
+    void (*_blit)(Uint32 *dst, const Uint32 *src, int count);
+    /** blit of a color through a coverage mask */
+    void (*_blit_a8)(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color);
+};
+
+/**
+ * divide by 255 with rounding. Exact for every x <= 255 * 255 and cheap to vectorise.
+ * @param x dividend
+ * @return x / 255 rounded to nearest
+ */
+inline Uint32 div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * premultiply the color channels of an ARGB8888 color with its alpha
+ * @param color color with straight alpha
+ * @return color with premultiplied alpha
+ */
+Uint32 premultiply(Uint32 color) {
+    Uint32 a = color >> 24;
+    Uint32 result = a << 24;
+    for (int shift = 0; shift < 24; shift += 8) {
+        result |= div255(((color >> shift) & 0xff) * a) << shift;
+    }
+    return result;
+}
+
+/**
+ * blend a pixel with straight alpha over another one
+ * @param d destination pixel
+ * @param s source pixel
+ * @return blended pixel
+ */
+inline Uint32 over(Uint32 d, Uint32 s) {
+    Uint32 a = s >> 24;
+    Uint32 inv = 255 - a;
+    /* the alpha channel is computed like a color channel with value 255 */
+    s |= 0xff000000;
+    Uint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= div255(((s >> shift) & 0xff) * a + ((d >> shift) & 0xff) * inv) << shift;
+    }
+    return result;
+}
+
+void fill_scalar(Uint32 *dst, int count, Uint32 premultiplied) {
+    Uint32 inv = 255 - (premultiplied >> 24);
+    for (int i = 0; i < count; ++i) {
+        Uint32 d = dst[i];
+        Uint32 result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            result |= (((premultiplied >> shift) & 0xff) + div255(((d >> shift) & 0xff) * inv))
+                      << shift;
+        }
+        dst[i] = result;
+    }
+}
+
+void blit_scalar(Uint32 *dst, const Uint32 *src, int count) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = over(dst[i], src[i]);
+    }
+}
+
+void blit_a8_scalar(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color) {
+    Uint32 alpha = color >> 24;
+    Uint32 rgb = color & 0x00ffffff;
+    for (int i = 0; i < count; ++i) {
+        dst[i] = over(dst[i], rgb | div255(coverage[i] * alpha) << 24);
+    }
+}
+
+#ifdef SDL_GUI_BLEND_X86
+/* Pixels get unpacked to 16 bit channels. All products are at most 255 * 255, so they fit. */
+
+__attribute__((target("sse2")))
+inline __m128i div255_sse2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/**
+ * blend two unpacked pixels with straight alpha over two others
+ * @param d unpacked destination pixels
+ * @param s unpacked source pixels
+ * @return unpacked blended pixels
+ */
+__attribute__((target("sse2")))
+inline __m128i over_sse2(__m128i d, __m128i s) {
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)),
+                                    _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    s = _mm_or_si128(s, _mm_set1_epi64x(0x00ff000000000000));
+    return div255_sse2(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, inv)));
+}
+
+/**
+ * blend four pixels with straight alpha over four others
+ * @param d destination pixels
+ * @param s source pixels
+ * @return blended pixels
+ */
+__attribute__((target("sse2")))
+inline __m128i over4_sse2(__m128i d, __m128i s) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = over_sse2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero));
+    __m128i hi = over_sse2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero));
+    return _mm_packus_epi16(lo, hi);
+}
+
+__attribute__((target("sse2")))
+void fill_sse2(Uint32 *dst, int count, Uint32 premultiplied) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i p = _mm_unpacklo_epi8(_mm_set1_epi32(premultiplied), zero);
+    __m128i inv = _mm_set1_epi16(255 - (premultiplied >> 24));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i lo = _mm_add_epi16(p, div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv)));
+        __m128i hi = _mm_add_epi16(p, div255_sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    fill_scalar(dst + i, count - i, premultiplied);
+}
+
+__attribute__((target("sse2")))
+void blit_sse2(Uint32 *dst, const Uint32 *src, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), over4_sse2(d, s));
+    }
+    blit_scalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("sse2")))
+void blit_a8_sse2(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i alpha = _mm_set1_epi16(color >> 24);
+    __m128i rgb = _mm_set1_epi32(color & 0x00ffffff);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int c;
+        std::memcpy(&c, coverage + i, sizeof(c));
+        __m128i cov = _mm_unpacklo_epi8(_mm_cvtsi32_si128(c), zero);
+        __m128i a = div255_sse2(_mm_mullo_epi16(cov, alpha));
+        __m128i s = _mm_or_si128(_mm_slli_epi32(_mm_unpacklo_epi16(a, zero), 24), rgb);
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), over4_sse2(d, s));
+    }
+    blit_a8_scalar(dst + i, coverage + i, count - i, color);
+}
+
+/* the AVX2 kernels work like the SSE2 ones on eight pixels at once. Unpacking and packing
+ * operate on both 128 bit lanes separately, so the pixel order is preserved. */
+
+__attribute__((target("avx2")))
+inline __m256i div255_avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+inline __m256i over_avx2(__m256i d, __m256i s) {
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)),
+                                       _MM_SHUFFLE(3, 3, 3, 3));
+    __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+    s = _mm256_or_si256(s, _mm256_set1_epi64x(0x00ff000000000000));
+    return div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, inv)));
+}
+
+__attribute__((target("avx2")))
+inline __m256i over8_avx2(__m256i d, __m256i s) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i lo = over_avx2(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero));
+    __m256i hi = over_avx2(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero));
+    return _mm256_packus_epi16(lo, hi);
+}
+
+__attribute__((target("avx2")))
+void fill_avx2(Uint32 *dst, int count, Uint32 premultiplied) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i p = _mm256_unpacklo_epi8(_mm256_set1_epi32(premultiplied), zero);
+    __m256i inv = _mm256_set1_epi16(255 - (premultiplied >> 24));
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i lo = _mm256_add_epi16(p, div255_avx2(_mm256_mullo_epi16(
+                                             _mm256_unpacklo_epi8(d, zero), inv)));
+        __m256i hi = _mm256_add_epi16(p, div255_avx2(_mm256_mullo_epi16(
+                                             _mm256_unpackhi_epi8(d, zero), inv)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    fill_sse2(dst + i, count - i, premultiplied);
+}
+
+__attribute__((target("avx2")))
+void blit_avx2(Uint32 *dst, const Uint32 *src, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), over8_avx2(d, s));
+    }
+    blit_sse2(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void blit_a8_avx2(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color) {
+    __m256i alpha = _mm256_set1_epi32(color >> 24);
+    __m256i rgb = _mm256_set1_epi32(color & 0x00ffffff);
+    __m256i half = _mm256_set1_epi32(128);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i c = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(coverage + i));
+        __m256i a = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvtepu8_epi32(c), alpha), half);
+        a = _mm256_srli_epi32(_mm256_add_epi32(a, _mm256_srli_epi32(a, 8)), 8);
+        __m256i s = _mm256_or_si256(_mm256_slli_epi32(a, 24), rgb);
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), over8_avx2(d, s));
+    }
+    blit_a8_sse2(dst + i, coverage + i, count - i, color);
+}
+#endif
+
+#ifdef __ARM_NEON
+/* NEON loads deinterleave eight pixels into one vector per channel */
+
+inline uint8x8_t div255_neon(uint16x8_t x) {
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+inline uint8x8x4_t over_neon(uint8x8x4_t d, uint8x8x4_t s) {
+    uint8x8_t a = s.val[3];
+    uint8x8_t inv = vsub_u8(vdup_n_u8(255), a);
+    s.val[3] = vdup_n_u8(255);
+    uint8x8x4_t result;
+    for (int c = 0; c < 4; ++c) {
+        result.val[c] = div255_neon(vmlal_u8(vmull_u8(s.val[c], a), d.val[c], inv));
+    }
+    return result;
+}
+
+void fill_neon(Uint32 *dst, int count, Uint32 premultiplied) {
+    uint8x8_t inv = vdup_n_u8(255 - (premultiplied >> 24));
+    uint8x8_t p[4];
+    for (int c = 0; c < 4; ++c) {
+        p[c] = vdup_n_u8((premultiplied >> (8 * c)) & 0xff);
+    }
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t *pixels = reinterpret_cast<uint8_t *>(dst + i);
+        uint8x8x4_t d = vld4_u8(pixels);
+        for (int c = 0; c < 4; ++c) {
+            d.val[c] = vadd_u8(p[c], div255_neon(vmull_u8(d.val[c], inv)));
+        }
+        vst4_u8(pixels, d);
+    }
+    fill_scalar(dst + i, count - i, premultiplied);
+}
+
+void blit_neon(Uint32 *dst, const Uint32 *src, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t *pixels = reinterpret_cast<uint8_t *>(dst + i);
+        uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + i));
+        vst4_u8(pixels, over_neon(vld4_u8(pixels), s));
+    }
+    blit_scalar(dst + i, src + i, count - i);
+}
+
+void blit_a8_neon(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color) {
+    uint8x8_t alpha = vdup_n_u8(color >> 24);
+    uint8x8x4_t s;
+    for (int c = 0; c < 3; ++c) {
+        s.val[c] = vdup_n_u8((color >> (8 * c)) & 0xff);
+    }
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t *pixels = reinterpret_cast<uint8_t *>(dst + i);
+        s.val[3] = div255_neon(vmull_u8(vld1_u8(coverage + i), alpha));
+        vst4_u8(pixels, over_neon(vld4_u8(pixels), s));
+    }
+    blit_a8_scalar(dst + i, coverage + i, count - i, color);
+}
+#endif
+
+const Kernels SCALAR_KERNELS = {blend::Implementation::SCALAR,
+                                fill_scalar, blit_scalar, blit_a8_scalar};
+#ifdef SDL_GUI_BLEND_X86
+const Kernels SSE2_KERNELS = {blend::Implementation::SSE2, fill_sse2, blit_sse2, blit_a8_sse2};
+const Kernels AVX2_KERNELS = {blend::Implementation::AVX2, fill_avx2, blit_avx2, blit_a8_avx2};
+#endif
+#ifdef __ARM_NEON
+const Kernels NEON_KERNELS = {blend::Implementation::NEON, fill_neon, blit_neon, blit_a8_neon};
+#endif
+
+/**
+ * get the kernels of an implementation
+ * @param implementation implementation to get kernels of
+ * @return kernels. nullptr if the CPU does not support them.
+ */
+const Kernels *kernels_of(blend::Implementation implementation) {
+    switch (implementation) {
+    case blend::Implementation::SCALAR:
+        return &SCALAR_KERNELS;
+#ifdef SDL_GUI_BLEND_X86
+    case blend::Implementation::SSE2:
+        return __builtin_cpu_supports("sse2") ? &SSE2_KERNELS : nullptr;
+    case blend::Implementation::AVX2:
+        return __builtin_cpu_supports("avx2") ? &AVX2_KERNELS : nullptr;
+#endif
+#ifdef __ARM_NEON
+    case blend::Implementation::NEON:
+        return &NEON_KERNELS;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * select the fastest implementation the CPU supports
+ * @return kernels of that implementation
+ */
+const Kernels *detect() {
+    for (blend::Implementation implementation: {blend::Implementation::AVX2,
+                                                blend::Implementation::SSE2,
+                                                blend::Implementation::NEON}) {
+        const Kernels *kernels = kernels_of(implementation);
+        if (kernels != nullptr) {
+            return kernels;
+        }
+    }
+    return &SCALAR_KERNELS;
+}
+
+/**
+ * get the kernels in use
+ * @return kernels in use
+ */
+std::atomic<const Kernels *> &current() {
+    static std::atomic<const Kernels *> kernels = detect();
+    return kernels;
+}
+
+/** surfaces that registered software renderers draw onto */
+std::map<SDL_Renderer *, SDL_Surface *> targets;
+/** mutex guarding targets */
+std::shared_mutex targets_mutex;
+
+/**
+ * clip a rect by the clip rect of a surface
+ * @param surface surface to clip by
+ * @param rect rect to clip
+ * @param[out] clipped clipped rect
+ * @return false if nothing is left
+ */
+bool clip(const SDL_Surface *surface, const SDL_Rect &rect, SDL_Rect *clipped) {
+    return SDL_IntersectRect(&rect, &surface->clip_rect, clipped);
+}
+
+/**
+ * get a row of pixels of an ARGB8888 surface
+ * @param surface surface to get row of
+ * @param x x coordinate of first pixel
+ * @param y y coordinate of row
+ * @return pointer to first pixel
+ */
+Uint32 *row_of(const SDL_Surface *surface, int x, int y) {
+    return reinterpret_cast<Uint32 *>(static_cast<Uint8 *>(surface->pixels) + y * surface->pitch)
+           + x;
+}
+
+/**
+ * convert a color to ARGB8888
+ * @param color color to convert
+ * @return ARGB8888 value
+ */
+Uint32 argb_of(RGB color) {
+    return static_cast<Uint32>(color._a) << 24 | static_cast<Uint32>(color._r) << 16
+           | static_cast<Uint32>(color._g) << 8 | color._b;
+}
+}
+
+blend::Implementation blend::implementation() {
+    return current().load()->_implementation;
+}
+
+bool blend::use(Implementation implementation) {
+    const Kernels *kernels = kernels_of(implementation);
+    if (kernels == nullptr) {
+        return false;
+    }
+    current() = kernels;
+    return true;
+}
+
+const char *blend::name(Implementation implementation) {
+    switch (implementation) {
+    case Implementation::SCALAR:
+        return "scalar";
+    case Implementation::SSE2:
+        return "SSE2";
+    case Implementation::AVX2:
+        return "AVX2";
+    case Implementation::NEON:
+        return "NEON";
+    }
+    return "unknown";
+}
+
+void blend::fill(Uint32 *dst, int count, Uint32 color) {
+    current().load()->_fill(dst, count, premultiply(color));
+}
+
+void blend::blit(Uint32 *dst, const Uint32 *src, int count) {
+    current().load()->_blit(dst, src, count);
+}
+
+void blend::blit_a8(Uint32 *dst, const Uint8 *coverage, int count, Uint32 color) {
+    current().load()->_blit_a8(dst, coverage, count, color);
+}
+
+void blend::fill_rect(SDL_Surface *surface, SDL_Rect rect, RGB color) {
+    SDL_Rect area;
+    if (not clip(surface, rect, &area)) {
+        return;
+    }
+    const Kernels *kernels = current();
+    Uint32 premultiplied = premultiply(argb_of(color));
+    for (int y = area.y; y < area.y + area.h; ++y) {
+        kernels->_fill(row_of(surface, area.x, y), area.w, premultiplied);
+    }
+}
+
+void blend::blit_surface(const SDL_Surface *src, SDL_Surface *dst, int x, int y) {
+    if (src->format->format != SDL_PIXELFORMAT_ARGB8888
+        or dst->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Rect dstrect = {x, y, 0, 0};
+        SDL_BlitSurface(const_cast<SDL_Surface *>(src), nullptr, dst, &dstrect);
+        return;
+    }
+    SDL_Rect area;
+    if (not clip(dst, {x, y, src->w, src->h}, &area)) {
+        return;
+    }
+    const Kernels *kernels = current();
+    for (int row = area.y; row < area.y + area.h; ++row) {
+        kernels->_blit(row_of(dst, area.x, row), row_of(src, area.x - x, row - y), area.w);
+    }
+}
+
+void blend::blit_scaled_surface(const SDL_Surface *src, SDL_Surface *dst, SDL_Rect rect) {
+    if (src->w == rect.w and src->h == rect.h) {
+        blend::blit_surface(src, dst, rect.x, rect.y);
+        return;
+    }
+    if (src->format->format != SDL_PIXELFORMAT_ARGB8888
+        or dst->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        return;
+    }
+    SDL_Rect area;
+    if (not clip(dst, rect, &area)) {
+        return;
+    }
+    std::vector<int> columns(area.w);
+    for (int column = 0; column < area.w; ++column) {
+        columns[column] = (area.x + column - rect.x) * src->w / rect.w;
+    }
+    std::vector<Uint32> scaled(area.w);
+    const Kernels *kernels = current();
+    for (int row = area.y; row < area.y + area.h; ++row) {
+        const Uint32 *source = row_of(src, 0, (row - rect.y) * src->h / rect.h);
+        for (int column = 0; column < area.w; ++column) {
+            scaled[column] = source[columns[column]];
+        }
+        kernels->_blit(row_of(dst, area.x, row), scaled.data(), area.w);
+    }
+}
+
+void blend::blit_a8_surface(const Uint8 *coverage, int width, int height, SDL_Surface *dst,
+                            int x, int y, RGB color) {
+    SDL_Rect area;
+    if (not clip(dst, {x, y, width, height}, &area)) {
+        return;
+    }
+    const Kernels *kernels = current();
+    Uint32 argb = argb_of(color);
+    for (int row = area.y; row < area.y + area.h; ++row) {
+        const Uint8 *mask = coverage + (row - y) * width + (area.x - x);
+        kernels->_blit_a8(row_of(dst, area.x, row), mask, area.w, argb);
+    }
+}
+
+void blend::register_target(SDL_Renderer *renderer, SDL_Surface *surface) {
+    if (surface == nullptr or surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        return;
+    }
+    std::unique_lock lock(targets_mutex);
+    targets[renderer] = surface;
+}
+
+void blend::unregister_target(SDL_Renderer *renderer) {
+    std::unique_lock lock(targets_mutex);
+    targets.erase(renderer);
+}
+
+SDL_Surface *blend::target_of(SDL_Renderer *renderer) {
+    SDL_Surface *surface;
+    {
+        std::shared_lock lock(targets_mutex);
+        auto it = targets.find(renderer);
+        if (it == targets.end()) {
+            return nullptr;
+        }
+        surface = it->second;
+    }
+    /* layers get rendered into textures, whose pixels are out of reach */
+    if (SDL_GetRenderTarget(renderer) != nullptr) {
+        return nullptr;
+    }
+    SDL_Rect viewport;
+    SDL_RenderGetViewport(renderer, &viewport);
+    if (viewport.x != 0 or viewport.y != 0 or viewport.w != surface->w
+        or viewport.h != surface->h) {
+        return nullptr;
+    }
+    float scale_x;
+    float scale_y;
+    SDL_RenderGetScale(renderer, &scale_x, &scale_y);
+    if (scale_x != 1.0f or scale_y != 1.0f) {
+        return nullptr;
+    }
+
+    /* everything queued so far has to be on the surface before drawing over it */
+    SDL_RenderFlush(renderer);
+    if (SDL_RenderIsClipEnabled(renderer)) {
+        SDL_Rect clip_rect;
+        SDL_RenderGetClipRect(renderer, &clip_rect);
+        SDL_SetClipRect(surface, &clip_rect);
+    } else {
+        SDL_SetClipRect(surface, nullptr);
+    }
+    return surface;
+}
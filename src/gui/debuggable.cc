@@ -9,6 +9,10 @@ Debuggable::Debuggable() {
                                               std::placeholders::_3);
 }
 
+Debuggable::Debuggable(const Debuggable &debuggable) : Debuggable() {
+    (void) debuggable;
+}
+
 Debuggable::~Debuggable() {
     for (const auto &[d, _]: this->_debug_information) {
         delete d;
@@ -24,6 +28,7 @@ void Debuggable::default_draw_debug_information(SDL_Renderer *renderer, Position
         wrapper->map([](Drawable *d) {
                 d->recalculate();
             });
+        wrapper->update_layout();
         wrapper->render(renderer, position, parent_clip_rect, false, true);
     }
 }
@@ -1,63 +1,253 @@
 #include <gui/drawable.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 
 #include <SDL2_gfx/SDL2_gfxPrimitives.h>
 
 #include <gui/primitives/text.h>
 #include <gui/primitives/wrap_rect.h>
+#include <gui/tree_transaction.h>
 #include <models/interface_model.h>
+#include <util/slab_allocator.h>
 
 using namespace SDL_GUI;
 
-const InterfaceModel *Drawable::_interface_model = nullptr;
+HandleTable<Drawable> Drawable::_handles;
+
+std::atomic<unsigned long> Drawable::_geometry_generation = 1;
+
+std::atomic<unsigned long> Drawable::_geometry_stamps = 0;
+
+/** parent clip rect of the childs of scroll containers, which get clipped when being read */
+static const SDL_Rect UNCLIPPED = {-(1 << 28), -(1 << 28), 1 << 29, 1 << 29};
+
+/** granularity of drawable sizes that share a slab allocator */
+static const size_t SIZE_CLASS = 16;
+
+/** drawables above this size get allocated with the default allocator */
+static const size_t MAX_POOLED_SIZE = 2048;
+
+/**
+ * get the slab allocator for drawables of a given size
+ * @param size size of drawable
+ * @return slab allocator. nullptr if drawables of this size do not get pooled.
+ */
+static SlabAllocator *drawable_pool(size_t size) {
+    /* the pools are never destroyed since drawables may outlive static objects */
+    static std::vector<SlabAllocator *> *pools = [](){
+        std::vector<SlabAllocator *> *pools = new std::vector<SlabAllocator *>();
+        if (std::getenv("SDL_GUI_NO_SLAB") == nullptr) {
+            for (size_t s = SIZE_CLASS; s <= MAX_POOLED_SIZE; s += SIZE_CLASS) {
+                pools->push_back(new SlabAllocator(s));
+            }
+        }
+        return pools;
+    }();
+    size_t index = (size + SIZE_CLASS - 1) / SIZE_CLASS - 1;
+    if (index >= pools->size()) {
+        return nullptr;
+    }
+    return (*pools)[index];
+}
+
+void *Drawable::operator new(size_t size) {
+    SlabAllocator *pool = drawable_pool(size);
+    if (pool == nullptr) {
+        return ::operator new(size);
+    }
+    return pool->allocate();
+}
+
+void Drawable::operator delete(void *drawable, size_t size) {
+    SlabAllocator *pool = drawable_pool(size);
+    if (pool == nullptr) {
+        ::operator delete(drawable);
+        return;
+    }
+    pool->deallocate(drawable);
+}
 
 Drawable::Drawable(std::string type, Position position,
                    std::function<void ()> init_debug_information_callback)
-    : Scrollable(position), _type(type) {
+    : Scrollable(position), _cold(std::make_unique<Cold>()) {
+    this->_handle = Drawable::_handles.insert(this);
+    this->_cold->_type = type;
     if (init_debug_information_callback) {
-        this->_init_debug_information_callback = init_debug_information_callback;
+        this->_cold->_init_debug_information_callback = init_debug_information_callback;
     } else {
-        this->_init_debug_information_callback =
+        this->_cold->_init_debug_information_callback =
             std::bind(&Drawable::default_init_debug_information, this);
     }
 }
 
+Drawable::Drawable(const Drawable &drawable)
+    : Hoverable(drawable), Scrollable(drawable), Attributable(drawable), Debuggable(drawable),
+      _cold(std::make_unique<Cold>(*drawable._cold)), _cached(drawable._cached),
+      _interface_model(drawable._interface_model), _style(drawable._style) {
+    this->_handle = Drawable::_handles.insert(this);
+    this->_cold->_init_debug_information_callback =
+        std::bind(&Drawable::default_init_debug_information, this);
+}
+
 Drawable::~Drawable() {
+    Drawable::_handles.erase(this->_handle);
+    if (this->_cached and this->_interface_model) {
+        this->_interface_model->layer_cache()->release(this);
+    }
     for (Drawable *child: this->_children) {
         delete child;
     }
 }
 
-void Drawable::apply_parents_absolute_position(Position parent_position) {
-    Position absolute_position = this->position() + parent_position;
-    this->set_absolute_position(absolute_position);
-    for (Drawable *d: this->_children) {
-        d->apply_parents_absolute_position(absolute_position);
+void Drawable::invalidate_geometry() {
+    this->_geometry_dirty = true;
+    TreeTransaction *transaction = TreeTransaction::current();
+    if (transaction) {
+        transaction->defer_geometry();
+    } else {
+        Drawable::_geometry_generation++;
     }
 }
 
-void Drawable::apply_parents_clip_rect(SDL_Rect parent_clip_rect) {
-    this->_parent_clip_rect = parent_clip_rect;
-    int new_x = std::max(parent_clip_rect.x, this->_absolute_position._x);
-    int new_y = std::max(parent_clip_rect.y, this->_absolute_position._y);
-    int new_width = std::min(parent_clip_rect.x + parent_clip_rect.w,
-                             static_cast<int>(new_x + this->_width)) - new_x;
-    int new_height = std::min(parent_clip_rect.y + parent_clip_rect.h,
-                              static_cast<int>(new_y + this->_height)) - new_y;
-    SDL_Rect clip_rect = {new_x, new_y, new_width, new_height};
+void Drawable::resolve_from_parent() const {
+    unsigned long generation = Drawable::_geometry_generation;
+    if (this->_verified_generation == generation) {
+        return;
+    }
+    const Drawable *parent = this->_parent;
+    if (this->_geometry_dirty
+        or (parent and this->_parent_geometry_stamp != parent->_geometry_stamp)) {
+        /* the derived geometry is a cache of the const drawable */
+        Drawable *self = const_cast<Drawable *>(this);
+        Position absolute_position = this->position_ref();
+        if (parent) {
+            absolute_position += parent->absolute_position_ref();
+            if (parent->is_scroll_container()) {
+                /* the content moves beneath the clip rect of the container when scrolling */
+                self->parent_clip_rect_ref() = UNCLIPPED;
+                this->_scroll_container = parent;
+            } else {
+                self->parent_clip_rect_ref() = parent->clip_rect_ref();
+                this->_scroll_container = parent->_scroll_container;
+            }
+        }
+        self->absolute_position_ref() = absolute_position;
+
+        SDL_Rect parent_clip_rect = this->parent_clip_rect_ref();
+        int new_x = std::max(parent_clip_rect.x, absolute_position._x);
+        int new_y = std::max(parent_clip_rect.y, absolute_position._y);
+        int new_width = std::min(parent_clip_rect.x + parent_clip_rect.w,
+                                 static_cast<int>(new_x + this->width_ref())) - new_x;
+        int new_height = std::min(parent_clip_rect.y + parent_clip_rect.h,
+                                  static_cast<int>(new_y + this->height_ref())) - new_y;
+        self->clip_rect_ref() = {new_x, new_y, new_width, new_height};
+
+        if (this->_cached and this->_interface_model) {
+            this->_interface_model->layer_cache()->invalidate(this);
+        }
+        this->_geometry_stamp = ++Drawable::_geometry_stamps;
+        this->_parent_geometry_stamp = parent ? parent->_geometry_stamp : 0;
+        this->_geometry_dirty = false;
+    }
+    this->_verified_generation = generation;
+}
 
-    this->set_clip_rect(clip_rect);
-    for (Drawable *d: this->_children) {
-        d->apply_parents_clip_rect(clip_rect);
+void Drawable::resolve_geometry() const {
+    if (this->_verified_generation == Drawable::_geometry_generation) {
+        return;
+    }
+    if (this->_parent) {
+        this->_parent->resolve_geometry();
+    }
+    this->resolve_from_parent();
+}
+
+Position Drawable::absolute_position() const {
+    this->resolve_geometry();
+    return this->absolute_position_ref() + this->scroll_offset();
+}
+
+SDL_Rect Drawable::clip_rect() const {
+    this->resolve_geometry();
+    SDL_Rect clip_rect = this->clip_rect_ref();
+    if (this->_scroll_container == nullptr) {
+        return clip_rect;
+    }
+    Position offset = this->scroll_offset();
+    clip_rect.x += offset._x;
+    clip_rect.y += offset._y;
+    SDL_Rect container_clip_rect = this->_scroll_container->clip_rect();
+    SDL_Rect intersection;
+    if (not SDL_IntersectRect(&clip_rect, &container_clip_rect, &intersection)) {
+        return {clip_rect.x, clip_rect.y, 0, 0};
+    }
+    return intersection;
+}
+
+Position Drawable::scroll_offset() const {
+    Position offset = {0, 0};
+    for (const Drawable *d = this->_scroll_container; d != nullptr; d = d->_scroll_container) {
+        offset += d->_scroll_position;
     }
+    return offset;
 }
 
-void Drawable::set_interface_model(InterfaceModel *interface_model) {
-    if (Drawable::_interface_model) {
+SDL_Rect Drawable::window_clip_rect(Position position, SDL_Rect parent_clip_rect) const {
+    SDL_Rect bounds = {position._x, position._y, static_cast<int>(this->width_ref()),
+                       static_cast<int>(this->height_ref())};
+    SDL_Rect clip_rect;
+    if (not SDL_IntersectRect(&bounds, &parent_clip_rect, &clip_rect)) {
+        return {0, 0, 0, 0};
+    }
+    return clip_rect;
+}
+
+void Drawable::resolve_subtree_geometry() const {
+    unsigned long generation = Drawable::_geometry_generation;
+    if (this->_subtree_verified_generation == generation) {
         return;
     }
-    Drawable::_interface_model = interface_model;
+    this->resolve_geometry();
+    this->resolve_children_geometry(generation);
+}
+
+void Drawable::resolve_children_geometry(unsigned long generation) const {
+    for (const Drawable *child: this->_children) {
+        child->resolve_from_parent();
+        if (child->_subtree_verified_generation != generation) {
+            child->resolve_children_geometry(generation);
+        }
+    }
+    this->_subtree_verified_generation = generation;
+}
+
+void Drawable::set_interface_model(const InterfaceModel *interface_model,
+                                   bool is_debug_information) {
+    this->_interface_model = interface_model;
+    /* the root of a tree does not get debug information */
+    if (not is_debug_information and this->_parent) {
+        this->init_debug_information();
+    }
+    for (Drawable *d: this->_children) {
+        d->set_interface_model(interface_model, is_debug_information);
+    }
+    for (const auto &[d, _]: this->_debug_information) {
+        d->set_interface_model(interface_model, true);
+    }
+}
+
+const std::string &Drawable::type() const {
+    return this->_cold->_type;
+}
+
+Handle Drawable::handle() const {
+    return this->_handle;
+}
+
+Drawable *Drawable::from_handle(Handle handle) {
+    return Drawable::_handles.get(handle);
 }
 
 Drawable *Drawable::parent() {
@@ -66,62 +256,95 @@ Drawable *Drawable::parent() {
 
 void Drawable::set_parent(Drawable *parent) {
     this->_parent = parent;
-    this->apply_parents_absolute_position(parent->_absolute_position);
-    this->apply_parents_clip_rect(parent->_clip_rect);
+    this->invalidate_geometry();
 }
 
 std::list<Drawable *> Drawable::children(bool reversed) {
-    return reversed ? this->_children_reversed : this->_children;
+    if (reversed) {
+        return std::list<Drawable *>(this->_children.rbegin(), this->_children.rend());
+    }
+    return std::list<Drawable *>(this->_children.begin(), this->_children.end());
 }
 
 const std::list<Drawable *> Drawable::children(bool reversed) const {
-    return reversed ? this->_children_reversed : this->_children;
+    if (reversed) {
+        return std::list<Drawable *>(this->_children.rbegin(), this->_children.rend());
+    }
+    return std::list<Drawable *>(this->_children.begin(), this->_children.end());
+}
+
+const std::vector<Drawable *> &Drawable::children_ref() const {
+    return this->_children;
 }
 
 void Drawable::add_child(Drawable *child, bool is_debug_information) {
     this->_children.push_back(child);
-    this->_children_reversed.push_front(child);
-    if (not is_debug_information) {
+    child->set_parent(this);
+    if (child->_interface_model != this->_interface_model) {
+        child->set_interface_model(this->_interface_model, is_debug_information);
+    } else if (not is_debug_information) {
         child->init_debug_information();
     }
-    child->set_parent(this);
+    /* outdated layouts of the child have to be reachable from the new parents */
+    for (Drawable *d = this; child->_layout_pending and d and not d->_layout_pending;
+         d = d->_parent) {
+        d->_layout_pending = true;
+    }
+    this->hook_post_child_change(child);
+    this->invalidate();
 }
 
 void Drawable::add_children(std::vector<Drawable *> children, bool is_debug_information) {
+    TreeTransaction transaction;
     for (Drawable *child: children) {
         this->add_child(child, is_debug_information);
     }
 }
 
 void Drawable::sort_children(std::function<bool (Drawable *, Drawable *)> f) {
-    this->_children.sort(f);
-    this->_children_reversed.clear();
-    for (Drawable *child: this->_children) {
-        this->_children_reversed.push_front(child);
-    }
+    std::stable_sort(this->_children.begin(), this->_children.end(), f);
+    this->hook_post_child_change(nullptr);
+    this->invalidate();
 }
 
 void Drawable::remove_children(std::function<bool(Drawable *)> f) {
-    std::list<Drawable *> new_children;
-    std::list<Drawable *> new_children_reversed;
+    std::vector<Drawable *> new_children;
     for (Drawable *child: this->_children) {
         if (f(child)) {
-            delete child;
+            this->dispose(child);
         } else {
             new_children.push_back(child);
-            new_children_reversed.push_front(child);
         }
     }
-    this->_children = new_children;
-    this->_children_reversed = new_children_reversed;
+    this->_children = std::move(new_children);
+    this->hook_post_child_change(nullptr);
+    this->invalidate();
 }
 
 void Drawable::remove_all_children() {
     for (Drawable *child: this->_children) {
-        delete child;
+        this->dispose(child);
     }
     this->_children.clear();
-    this->_children_reversed.clear();
+    this->hook_post_child_change(nullptr);
+    this->invalidate();
+}
+
+void Drawable::dispose(Drawable *child) {
+    if (this->_interface_model == nullptr) {
+        delete child;
+        return;
+    }
+    std::vector<Handle> handles;
+    std::vector<const Drawable *> stack = {child};
+    while (not stack.empty()) {
+        const Drawable *d = stack.back();
+        stack.pop_back();
+        handles.push_back(d->_handle);
+        stack.insert(stack.end(), d->_children.begin(), d->_children.end());
+    }
+    Drawable::_handles.erase(handles);
+    this->_interface_model->reclaim(child);
 }
 
 std::vector<Drawable *> Drawable::find(std::function<bool (Drawable *)> f) {
@@ -274,7 +497,7 @@ void Drawable::default_init_debug_information() {
             return this->_interface_model->debug_information_drawn();
         });
 
-    Text *position_text = new Text(InterfaceModel::font(), position_string.str());
+    Text *position_text = new Text(this->_interface_model->font(), position_string.str());
     position_text->set_position({3,3});
     position_text->add_attribute("debug");
     Drawable *drawable = this;
@@ -285,7 +508,7 @@ void Drawable::default_init_debug_information() {
         });
     rect->add_child(position_text, true);
 
-    Text *attribute_text = new Text(InterfaceModel::font(), attribute_string.str());
+    Text *attribute_text = new Text(this->_interface_model->font(), attribute_string.str());
     /* TODO: get rid of magic numbers */
     attribute_text->set_position({3,16});
     attribute_text->add_attribute("debug");
@@ -293,41 +516,83 @@ void Drawable::default_init_debug_information() {
 }
 
 void Drawable::init_debug_information() {
-    if (this->_debug_information_initialised) {
+    /* the font is only known once the drawable is attached to a tree */
+    if (this->_debug_information_initialised or not this->_interface_model) {
+        return;
+    }
+    TreeTransaction *transaction = TreeTransaction::current();
+    if (transaction) {
+        transaction->defer_debug_information(this);
         return;
     }
-    this->_init_debug_information_callback();
+    this->_cold->_init_debug_information_callback();
     this->_debug_information_initialised = true;
+    for (const auto &[d, _]: this->_debug_information) {
+        d->set_interface_model(this->_interface_model, true);
+    }
 }
 
 void Drawable::hook_post_move(Position offset) {
-    this->apply_parents_clip_rect(this->_parent_clip_rect);
-    for (Drawable *child: this->_children) {
-        child->map([offset](Drawable *d){
-            d->move_absolute(offset);
-        });
+    (void) offset;
+    /* childs follow once they get resolved */
+    this->invalidate_geometry();
+    this->invalidate();
+    if (this->_parent) {
+        this->_parent->hook_post_child_change(this);
     }
 }
 
 void Drawable::hook_post_resize(unsigned width, unsigned height) {
-    this->_clip_rect.w = width;
-    this->_clip_rect.h = height;
-    this->apply_parents_clip_rect(this->_parent_clip_rect);
+    (void) width;
+    (void) height;
+    this->invalidate_geometry();
+    this->invalidate();
+    if (this->_parent) {
+        this->_parent->hook_post_child_change(this);
+    }
 }
 
 void Drawable::hook_post_scroll(Position scroll_offset) {
+    (void) scroll_offset;
+    /* the stored geometry of the childs does not contain the scroll position. It gets added when
+     * rendering and when reading their geometry in window coordinates. */
+    this->invalidate();
+}
+
+void Drawable::hook_post_toggle_scrolling() {
+    /* the childs store their clip rects with or without the one of this */
+    this->invalidate_geometry();
+}
+
+void Drawable::request_layout() {
+    this->_layout_dirty = true;
+    for (Drawable *d = this; d != nullptr and not d->_layout_pending; d = d->_parent) {
+        d->_layout_pending = true;
+    }
+}
+
+void Drawable::update_layout() {
+    if (not this->_layout_pending) {
+        return;
+    }
     for (Drawable *child: this->_children) {
-        child->move(scroll_offset);
+        child->update_layout();
+    }
+    if (this->_layout_dirty) {
+        this->layout();
     }
+    /* changes of the children caused by this layout are part of it */
+    this->_layout_dirty = false;
+    this->_layout_pending = false;
 }
 
 void Drawable::add_recalculation_callback(std::function<void(Drawable *)> callback) {
-    this->_recalculation_callbacks.push_back(callback);
+    this->_cold->_recalculation_callbacks.push_back(callback);
 }
 
 void Drawable::recalculate() {
     this->update();
-    for (std::function<void(Drawable *)> callback: this->_recalculation_callbacks) {
+    for (std::function<void(Drawable *)> callback: this->_cold->_recalculation_callbacks) {
         callback(this);
     }
 }
@@ -335,25 +600,140 @@ void Drawable::recalculate() {
 void Drawable::render(SDL_Renderer *renderer, Position parent_position, SDL_Rect parent_clip_rect,
                       bool hidden, bool is_debug_information) const {
     this->hook_pre_render();
-    Position position = parent_position + this->_position;
+    Position position = parent_position + this->position_ref();
     if (hidden || this->is_hidden()) {
         return;
     }
-    SDL_RenderSetClipRect(renderer, &parent_clip_rect);
-    this->draw(renderer, position);
+    /* children are clipped to the own clip rect. If that is empty as well as the intersection of
+     * the own draw bounds with the parents clip rect, nothing of this subtree is visible. */
+    SDL_Rect clip_rect = this->window_clip_rect(position, parent_clip_rect);
+    if (not is_debug_information and SDL_RectEmpty(&clip_rect)) {
+        SDL_Rect bounds = this->draw_bounds(position);
+        if (not SDL_HasIntersection(&bounds, &parent_clip_rect)) {
+            if (this->_interface_model) {
+                this->_interface_model->render_stats()->_culled_subtrees++;
+            }
+            return;
+        }
+    }
+    if (this->_cached and not is_debug_information
+        and this->render_layer(renderer, position, parent_clip_rect)) {
+        return;
+    }
+    this->render_content(renderer, position, parent_clip_rect, is_debug_information);
+}
+
+void Drawable::render_content(SDL_Renderer *renderer, Position position, SDL_Rect parent_clip_rect,
+                              bool is_debug_information) const {
+    RenderStats *render_stats = nullptr;
+    if (this->_interface_model) {
+        render_stats = this->_interface_model->render_stats();
+    }
+
+    SDL_Rect bounds = this->draw_bounds(position);
+    SDL_Rect visible_bounds = bounds;
+    bool is_visible = is_debug_information
+                      or SDL_IntersectRect(&bounds, &parent_clip_rect, &visible_bounds);
+    bool is_occluded = is_visible and not is_debug_information and render_stats
+                       and this->_occluded_frame == render_stats->_frame;
+    if (is_visible and not is_occluded) {
+        SDL_RenderSetClipRect(renderer, &parent_clip_rect);
+        this->draw(renderer, position);
+    }
+    if (render_stats) {
+        unsigned long pixels = static_cast<unsigned long>(visible_bounds.w) * visible_bounds.h;
+        if (not is_visible) {
+            render_stats->_culled++;
+        } else if (is_occluded) {
+            render_stats->_occluded++;
+            render_stats->_pixels_occluded += pixels;
+        } else {
+            render_stats->_drawn++;
+            render_stats->_pixels_drawn += pixels;
+        }
+    }
 
-    SDL_Rect clip_rect = is_debug_information ? parent_clip_rect : this->_clip_rect;
+    SDL_Rect clip_rect = parent_clip_rect;
+    if (not is_debug_information) {
+        clip_rect = this->window_clip_rect(position, parent_clip_rect);
+    }
 
-    /* draw children */
-    for (Drawable *child: this->_children) {
-        child->render(renderer, position, clip_rect, false, is_debug_information);
+    /* draw children. An empty clip rect would disable clipping in SDL instead. */
+    if (is_debug_information or not SDL_RectEmpty(&clip_rect)) {
+        Position children_position = position + this->_scroll_position;
+        for (Drawable *child: this->_children) {
+            child->render(renderer, children_position, clip_rect, false, is_debug_information);
+        }
+    } else if (render_stats and not this->_children.empty()) {
+        render_stats->_culled_subtrees++;
     }
 
-    SDL_RenderSetClipRect(renderer, &parent_clip_rect);
-    this->draw_border(renderer, position);
-    if (not is_debug_information) {
-        this->draw_debug_information(renderer, position, this->_clip_rect);
+    if (is_visible) {
+        SDL_RenderSetClipRect(renderer, &parent_clip_rect);
+        this->draw_border(renderer, position);
+    }
+    /* the clip rect walks the scroll containers, so it only gets computed if debug information is
+     * shown at all */
+    if (not is_debug_information and this->_interface_model
+        and this->_interface_model->debug_information_drawn()) {
+        this->draw_debug_information(renderer, position, this->clip_rect());
+    }
+}
+
+bool Drawable::render_layer(SDL_Renderer *renderer, Position position,
+                            SDL_Rect parent_clip_rect) const {
+    /* debug information changes every frame and is never cached */
+    if (not this->_interface_model or this->_interface_model->debug_information_drawn()) {
+        return false;
+    }
+    /* layers belong to the models renderer. Tiles get rendered with other renderers. */
+    if (renderer != this->_interface_model->renderer()) {
+        return false;
+    }
+    if (this->width() == 0 or this->height() == 0) {
+        return false;
+    }
+    /* borders are drawn up to and including the right and bottom edge */
+    int width = this->width() + 1;
+    int height = this->height() + 1;
+
+    RenderStats *render_stats = this->_interface_model->render_stats();
+    if (this->_occluded_frame == render_stats->_frame) {
+        render_stats->_occluded++;
+        render_stats->_pixels_occluded += static_cast<unsigned long>(width) * height;
+        return true;
+    }
+
+    LayerCache *layer_cache = this->_interface_model->layer_cache();
+    SDL_Texture *layer = layer_cache->find(this);
+    if (layer == nullptr) {
+        layer = layer_cache->acquire(this, renderer, width, height);
+        if (layer == nullptr) {
+            return false;
+        }
+        SDL_Texture *target = SDL_GetRenderTarget(renderer);
+        SDL_Rect viewport;
+        SDL_RenderGetViewport(renderer, &viewport);
+
+        SDL_SetRenderTarget(renderer, layer);
+        /* shift the viewport so that window coordinates of this drawable map to the layers origin */
+        SDL_Rect layer_viewport = {-position._x, -position._y, position._x + width,
+                                   position._y + height};
+        SDL_RenderSetViewport(renderer, &layer_viewport);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        SDL_Rect layer_clip_rect = {position._x, position._y, width, height};
+        this->render_content(renderer, position, layer_clip_rect, false);
+
+        SDL_SetRenderTarget(renderer, target);
+        SDL_RenderSetViewport(renderer, &viewport);
+        layer_cache->unpin(layer);
     }
+
+    SDL_RenderSetClipRect(renderer, &parent_clip_rect);
+    SDL_Rect destination = {position._x, position._y, width, height};
+    SDL_RenderCopy(renderer, layer, nullptr, &destination);
+    return true;
 }
 
 void Drawable::draw_border(SDL_Renderer *renderer, Position position) const {
@@ -363,33 +743,153 @@ void Drawable::draw_border(SDL_Renderer *renderer, Position position) const {
     for (int i = 0; i < static_cast<int>(this->_style._border_width); ++i) {
         const RGB &c = this->_style._border_color;
         rectangleRGBA(renderer, position._x + i, position._y + i,
-                      position._x + this->_width - i, position._y + this->_height - i,
+                      position._x + this->width_ref() - i, position._y + this->height_ref() - i,
                       c._r, c._g, c._b, c._a);
     }
 }
 
+SDL_Rect Drawable::draw_bounds(Position position) const {
+    /* borders are drawn up to and including the right and bottom edge */
+    int border = this->_style._has_border ? 1 : 0;
+    return {position._x, position._y, static_cast<int>(this->width()) + border,
+            static_cast<int>(this->height()) + border};
+}
+
+bool Drawable::is_opaque() const {
+    return false;
+}
+
+void Drawable::cull_occluded(Position parent_position, SDL_Rect parent_clip_rect,
+                             std::vector<SDL_Rect> *occluders, unsigned long frame) const {
+    if (this->is_hidden()) {
+        return;
+    }
+    Position position = parent_position + this->position_ref();
+
+    /* everything drawn after this drawable comes first */
+    SDL_Rect clip_rect = this->window_clip_rect(position, parent_clip_rect);
+    if (not this->_cached and not SDL_RectEmpty(&clip_rect)) {
+        Position children_position = position + this->_scroll_position;
+        for (auto child = this->_children.rbegin(); child != this->_children.rend(); ++child) {
+            (*child)->cull_occluded(children_position, clip_rect, occluders, frame);
+        }
+    }
+
+    /* cached drawables get copied as a whole layer, but only their own bounds are opaque */
+    SDL_Rect bounds = this->draw_bounds(position);
+    SDL_Rect visible_bounds;
+    if (not SDL_IntersectRect(&bounds, &parent_clip_rect, &visible_bounds)) {
+        return;
+    }
+    SDL_Rect opaque_bounds = visible_bounds;
+    if (this->_cached) {
+        bounds = {position._x, position._y, static_cast<int>(this->width()) + 1,
+                  static_cast<int>(this->height()) + 1};
+        SDL_IntersectRect(&bounds, &parent_clip_rect, &visible_bounds);
+    }
+    for (const SDL_Rect &occluder: *occluders) {
+        SDL_Rect covered;
+        if (SDL_IntersectRect(&visible_bounds, &occluder, &covered)
+            and covered.w == visible_bounds.w and covered.h == visible_bounds.h) {
+            this->_occluded_frame = frame;
+            return;
+        }
+    }
+    if (this->is_opaque()) {
+        occluders->push_back(opaque_bounds);
+    }
+}
+
 void Drawable::show() {
+    bool was_hidden = this->hidden_ref();
+    this->hidden_ref() = false;
     this->_style._hidden = false;
+    this->invalidate();
+    if (was_hidden and this->_parent) {
+        this->_parent->hook_post_child_change(this);
+    }
 }
 
 void Drawable::hide() {
+    bool was_hidden = this->hidden_ref();
+    this->hidden_ref() = true;
     this->_style._hidden = true;
+    this->invalidate();
+    if (not was_hidden and this->_parent) {
+        this->_parent->hook_post_child_change(this);
+    }
 }
 
 bool Drawable::is_hidden() const {
-    return this->_style._hidden;
+    return this->hidden_ref();
 }
 
 Drawable *Drawable::deepcopy() const {
     Drawable *new_root = this->clone();
-    new_root->_children.clear();
-    new_root->_children_reversed.clear();
     for (Drawable *child: this->_children) {
         new_root->add_child(child->deepcopy());
     }
     return new_root;
 }
 
+Drawable *Drawable::snapshot() const {
+    this->resolve_subtree_geometry();
+    return this->snapshot(nullptr);
+}
+
+Drawable *Drawable::snapshot(Drawable *parent_copy) const {
+    Drawable *copy = this->clone();
+    if (parent_copy != nullptr) {
+        /* the childs of the copy look up their scroll container through it */
+        copy->_parent = parent_copy;
+        copy->_scroll_container = this->_scroll_container == this->_parent
+                                  ? parent_copy : parent_copy->_scroll_container;
+    }
+    /* the stamps keep the copies consistent with each other, so they count as resolved */
+    copy->_geometry_dirty = false;
+    copy->_geometry_stamp = this->_geometry_stamp;
+    copy->_parent_geometry_stamp = this->_parent_geometry_stamp;
+    copy->_verified_generation = this->_verified_generation;
+    copy->_subtree_verified_generation = this->_subtree_verified_generation;
+    copy->_cold->_recalculation_callbacks.clear();
+    copy->_debug_information_initialised = true;
+    /* layers are keyed by drawable and would get rebuilt for every snapshot */
+    copy->_cached = false;
+    copy->_children.reserve(this->_children.size());
+    for (Drawable *child: this->_children) {
+        copy->_children.push_back(child->snapshot(copy));
+    }
+    return copy;
+}
+
+void Drawable::set_cached(bool cached) {
+    if (this->_cached and not cached and this->_interface_model) {
+        this->_interface_model->layer_cache()->release(this);
+    }
+    this->_cached = cached;
+}
+
+bool Drawable::is_cached() const {
+    return this->_cached;
+}
+
+void Drawable::invalidate() {
+    if (not this->_interface_model) {
+        return;
+    }
+    TreeTransaction *transaction = TreeTransaction::current();
+    if (transaction) {
+        transaction->defer_invalidate(this);
+        return;
+    }
+    LayerCache *layer_cache = this->_interface_model->layer_cache();
+    for (const Drawable *d = this; d != nullptr; d = d->_parent) {
+        if (d->_cached) {
+            layer_cache->invalidate(d);
+        }
+    }
+}
+
 Drawable *NullDrawable::clone() const {
     return new NullDrawable(*this);
 }
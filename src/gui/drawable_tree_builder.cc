@@ -2,17 +2,37 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <sstream>
 
 #include <gui/primitives/rect.h>
+#include <gui/primitives/stack.h>
 #include <gui/primitives/text.h>
 #include <gui/primitives/vertical_line.h>
+#include <gui/tree_transaction.h>
 
 using namespace SDL_GUI;
 
+/**
+ * parse a length like the spacing or padding of a stack
+ * @param value attribute value
+ * @return parsed length. 0 if the value is no non-negative number.
+ */
+static unsigned parse_length(const std::string &value) {
+    unsigned length = 0;
+    std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(),
+                                                    length);
+    if (result.ec != std::errc() or result.ptr != value.data() + value.size()) {
+        return 0;
+    }
+    return length;
+}
+
 void DrawableTreeBuilder::set_style(Drawable *drawable,
                                     std::map<std::string, std::string> attributes) {
+    /* position and size hooks only need to run once for all attributes */
+    TreeTransaction transaction;
     for (std::pair<std::string, std::string> attribute: attributes) {
         std::string key = attribute.first;
         std::string value = attribute.second;
@@ -41,6 +61,10 @@ void DrawableTreeBuilder::set_style(Drawable *drawable,
                 break;
             case StyleType::OVERFLOW:
                 drawable->_style._overflow = (value == "true");
+                break;
+            case StyleType::CACHE:
+                drawable->set_cached(value == "true");
+                break;
             default:
                 break;
         }
@@ -62,6 +86,26 @@ void DrawableTreeBuilder::set_color_of_drawable(Drawable *drawable, std::string
     drawable->_style._has_background = true;
 }
 
+Drawable *DrawableTreeBuilder::construct_stack(std::map<std::string, std::string> attributes) {
+    Stack::Direction direction = Stack::Direction::VERTICAL;
+    if (attributes["direction"] == "horizontal") {
+        direction = Stack::Direction::HORIZONTAL;
+    }
+    Stack *stack = new Stack(direction);
+    std::string align = attributes["align"];
+    if (align == "center") {
+        stack->set_alignment(Stack::Alignment::CENTER);
+    } else if (align == "end") {
+        stack->set_alignment(Stack::Alignment::END);
+    }
+    if (not attributes["spacing"].empty()) {
+        stack->set_spacing(parse_length(attributes["spacing"]));
+    }
+    if (not attributes["padding"].empty()) {
+        stack->set_padding(parse_length(attributes["padding"]));
+    }
+    return stack;
+}
 
 Drawable *DrawableTreeBuilder::construct_node(std::string type, std::string value,
                                               std::map<std::string, std::string> attributes) const {
@@ -78,6 +122,9 @@ Drawable *DrawableTreeBuilder::construct_node(std::string type, std::string valu
         case Type::VERTICAL_LINE:
             drawable = new VerticalLine();
             break;
+        case Type::STACK:
+            drawable = DrawableTreeBuilder::construct_stack(attributes);
+            break;
         default:
             drawable = new NullDrawable();
             break;
@@ -0,0 +1,188 @@
+#include <gui/frame_capture.h>
+
+#include <algorithm>
+#include <csignal>
+
+#include <pthread.h>
+
+#include <SDL2/SDL_image.h>
+
+using namespace SDL_GUI;
+
+FrameCapture::FrameCapture(std::string destination, Format format, int width, int height,
+                           unsigned buffers)
+    : _destination(destination), _format(format), _width(width), _height(height),
+      _frames(std::max(buffers, 1u)) {
+    for (Frame &frame: this->_frames) {
+        frame._pixels.resize(static_cast<size_t>(width) * height);
+        this->_free.push_back(&frame);
+    }
+
+    if (format == Format::RAW) {
+        if (destination == "-") {
+            this->_stream = stdout;
+        } else if (not destination.empty() and destination[0] == '|') {
+            this->_stream = popen(destination.substr(1).c_str(), "w");
+            this->_is_pipe = true;
+        } else {
+            this->_stream = fopen(destination.c_str(), "wb");
+        }
+        if (this->_stream == nullptr) {
+            this->_failed = true;
+        }
+    }
+
+    this->_writer = std::thread(&FrameCapture::write_frames, this);
+}
+
+FrameCapture::~FrameCapture() {
+    this->finish();
+}
+
+void FrameCapture::finish() {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_is_stopping = true;
+    }
+    this->_frame_pending.notify_one();
+    /* the writer closes the stream, as closing flushes it */
+    if (this->_writer.joinable()) {
+        this->_writer.join();
+    }
+}
+
+void FrameCapture::close_stream() {
+    if (this->_stream == nullptr) {
+        return;
+    }
+    if (this->_is_pipe) {
+        pclose(this->_stream);
+    } else if (this->_stream == stdout) {
+        fflush(this->_stream);
+    } else {
+        fclose(this->_stream);
+    }
+    this->_stream = nullptr;
+}
+
+bool FrameCapture::capture(SDL_Renderer *renderer) {
+    unsigned long number = this->_captured++;
+    Frame *frame;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        if (this->_is_stopping or this->_free.empty()) {
+            this->_dropped++;
+            return false;
+        }
+        frame = this->_free.front();
+        this->_free.pop_front();
+    }
+
+    /* frames keep their size even if the output of the renderer gets resized */
+    int output_width;
+    int output_height;
+    SDL_GetRendererOutputSize(renderer, &output_width, &output_height);
+    SDL_Rect rect = {0, 0, std::min(this->_width, output_width),
+                     std::min(this->_height, output_height)};
+    if (rect.w != this->_width or rect.h != this->_height) {
+        std::fill(frame->_pixels.begin(), frame->_pixels.end(), 0);
+    }
+    frame->_number = number;
+    bool is_read = rect.w > 0 and rect.h > 0
+                   and 0 == SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_ARGB8888,
+                                                 frame->_pixels.data(),
+                                                 this->_width * sizeof(Uint32));
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        if (not is_read) {
+            this->_free.push_back(frame);
+            this->_dropped++;
+            return false;
+        }
+        this->_pending.push_back(frame);
+    }
+    this->_frame_pending.notify_one();
+    return true;
+}
+
+void FrameCapture::write_frames() {
+    /* a terminated encoder must not kill the application. Writes to it fail with EPIPE instead. */
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    while (true) {
+        this->_frame_pending.wait(lock, [this](){
+                return this->_is_stopping or not this->_pending.empty();
+            });
+        if (this->_pending.empty()) {
+            /* stopping and everything is written */
+            lock.unlock();
+            this->close_stream();
+            return;
+        }
+        Frame *frame = this->_pending.front();
+        this->_pending.pop_front();
+        lock.unlock();
+
+        if (not this->_failed and this->write(frame)) {
+            this->_written++;
+        } else {
+            this->_failed = true;
+            this->_unwritten++;
+        }
+
+        lock.lock();
+        this->_free.push_back(frame);
+    }
+}
+
+bool FrameCapture::write(const Frame *frame) {
+    if (this->_format == Format::RAW) {
+        size_t count = frame->_pixels.size();
+        return fwrite(frame->_pixels.data(), sizeof(Uint32), count, this->_stream) == count;
+    }
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(
+        const_cast<Uint32 *>(frame->_pixels.data()), this->_width, this->_height, 32,
+        this->_width * sizeof(Uint32), SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr) {
+        return false;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "/frame_%06lu.png", frame->_number);
+    bool is_saved = 0 == IMG_SavePNG(surface, (this->_destination + name).c_str());
+    SDL_FreeSurface(surface);
+    return is_saved;
+}
+
+unsigned long FrameCapture::written() const {
+    return this->_written;
+}
+
+unsigned long FrameCapture::dropped() const {
+    return this->_dropped;
+}
+
+unsigned long FrameCapture::unwritten() const {
+    return this->_unwritten;
+}
+
+bool FrameCapture::failed() const {
+    return this->_failed;
+}
+
+bool FrameCapture::parse_format(const std::string &name, Format *format) {
+    if (name == "png") {
+        *format = Format::PNG;
+        return true;
+    }
+    if (name == "raw") {
+        *format = Format::RAW;
+        return true;
+    }
+    return false;
+}
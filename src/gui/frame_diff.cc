@@ -0,0 +1,83 @@
+#include <gui/frame_diff.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace SDL_GUI;
+
+/**
+ * get a pixel of an ARGB8888 surface
+ * @param surface the surface
+ * @param x x coordinate
+ * @param y y coordinate
+ * @return pixel value
+ */
+static Uint32 pixel_at(const SDL_Surface *surface, int x, int y) {
+    return reinterpret_cast<const Uint32 *>(static_cast<const Uint8 *>(surface->pixels)
+                                            + y * surface->pitch)[x];
+}
+
+FrameDiff SDL_GUI::compare_frames(SDL_Surface *expected, SDL_Surface *actual, unsigned tolerance,
+                                  SDL_Surface *diff_image) {
+    FrameDiff diff;
+    if (expected->w != actual->w or expected->h != actual->h) {
+        diff._same_size = false;
+        return diff;
+    }
+    SDL_Surface *a = SDL_ConvertSurfaceFormat(expected, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_Surface *b = SDL_ConvertSurfaceFormat(actual, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (a == nullptr or b == nullptr) {
+        SDL_FreeSurface(a);
+        SDL_FreeSurface(b);
+        diff._same_size = false;
+        return diff;
+    }
+    SDL_Surface *out = nullptr;
+    if (diff_image != nullptr and diff_image->w == expected->w
+        and diff_image->h == expected->h) {
+        out = diff_image;
+        SDL_LockSurface(out);
+    }
+
+    int min_x = a->w, min_y = a->h, max_x = -1, max_y = -1;
+    for (int y = 0; y < a->h; ++y) {
+        for (int x = 0; x < a->w; ++x) {
+            Uint32 pa = pixel_at(a, x, y);
+            Uint32 pb = pixel_at(b, x, y);
+            unsigned difference = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                int ca = (pa >> shift) & 0xff;
+                int cb = (pb >> shift) & 0xff;
+                difference = std::max(difference, static_cast<unsigned>(std::abs(ca - cb)));
+            }
+            diff._max_difference = std::max(diff._max_difference, difference);
+            bool differs = difference > tolerance;
+            if (differs) {
+                diff._differing_pixels++;
+                min_x = std::min(min_x, x);
+                min_y = std::min(min_y, y);
+                max_x = std::max(max_x, x);
+                max_y = std::max(max_y, y);
+            }
+            if (out != nullptr) {
+                Uint8 red = (pa >> 16) & 0xff, green = (pa >> 8) & 0xff, blue = pa & 0xff;
+                Uint32 value = differs ? SDL_MapRGBA(out->format, 255, 0, 0, 255)
+                                       : SDL_MapRGBA(out->format, 128 + red / 2, 128 + green / 2,
+                                                     128 + blue / 2, 255);
+                Uint8 *row = static_cast<Uint8 *>(out->pixels) + y * out->pitch;
+                std::copy_n(reinterpret_cast<const Uint8 *>(&value), out->format->BytesPerPixel,
+                            row + x * out->format->BytesPerPixel);
+            }
+        }
+    }
+    if (diff._differing_pixels > 0) {
+        diff._bounds = {min_x, min_y, max_x - min_x + 1, max_y - min_y + 1};
+    }
+
+    if (out != nullptr) {
+        SDL_UnlockSurface(out);
+    }
+    SDL_FreeSurface(a);
+    SDL_FreeSurface(b);
+    return diff;
+}
@@ -0,0 +1,134 @@
+#include <gui/geometry_store.h>
+
+using namespace SDL_GUI;
+
+struct GeometryStore::Local {
+    Geometry *_next = nullptr;      /**< next never used entry of the threads chunk */
+    Geometry *_end = nullptr;       /**< end of the threads chunk */
+    Batch *_free = nullptr;         /**< entries released on this thread */
+    bool _has_ended = false;        /**< flag that determines whether the thread is ending */
+};
+
+struct GeometryStore::LocalOwner {
+    ~LocalOwner() {
+        GeometryStore::instance()->hand_over_local();
+    }
+};
+
+GeometryStore::~GeometryStore() {
+    for (Chunk *chunk = this->_chunks.load(); chunk != nullptr;) {
+        Chunk *next = chunk->_next;
+        delete chunk;
+        chunk = next;
+    }
+    for (Batch *batch = this->_batches.load(); batch != nullptr;) {
+        Batch *next = batch->_next;
+        delete batch;
+        batch = next;
+    }
+}
+
+GeometryStore *GeometryStore::instance() {
+    static GeometryStore *store = new GeometryStore();
+    return store;
+}
+
+GeometryStore::Local &GeometryStore::local() {
+    /* the entries stay reachable for objects destroyed after the owner, e.g. static ones */
+    static thread_local Local local;
+    static thread_local LocalOwner owner;
+    return local;
+}
+
+void GeometryStore::hand_over(Batch *batch) {
+    batch->_next = this->_batches.load(std::memory_order_relaxed);
+    while (not this->_batches.compare_exchange_weak(batch->_next, batch,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {}
+}
+
+void GeometryStore::hand_over_local() {
+    Local &local = GeometryStore::local();
+    Batch *batch = local._free ? local._free : new Batch();
+    for (; local._next != local._end; ++local._next) {
+        batch->_entries.push_back(local._next);
+    }
+    if (batch->_entries.empty()) {
+        delete batch;
+    } else {
+        this->hand_over(batch);
+    }
+    local._free = nullptr;
+    local._next = nullptr;
+    local._end = nullptr;
+    local._has_ended = true;
+}
+
+Geometry *GeometryStore::allocate() {
+    Local &local = GeometryStore::local();
+    if ((local._free == nullptr or local._free->_entries.empty())
+        and this->_batches.load(std::memory_order_relaxed) != nullptr) {
+        /* all batches get taken at once, since single ones can not be taken without a lock */
+        Batch *batch = this->_batches.exchange(nullptr, std::memory_order_acquire);
+        while (batch != nullptr) {
+            Batch *next = batch->_next;
+            if (local._free == nullptr) {
+                batch->_next = nullptr;
+                local._free = batch;
+            } else {
+                local._free->_entries.insert(local._free->_entries.end(),
+                                             batch->_entries.begin(), batch->_entries.end());
+                delete batch;
+            }
+            batch = next;
+        }
+    }
+
+    Geometry *geometry;
+    if (local._free != nullptr and not local._free->_entries.empty()) {
+        geometry = local._free->_entries.back();
+        local._free->_entries.pop_back();
+        *geometry = Geometry();
+    } else {
+        if (local._next == local._end) {
+            /* entries of earlier chunks stay where they are */
+            Chunk *chunk = new Chunk();
+            chunk->_next = this->_chunks.load(std::memory_order_relaxed);
+            while (not this->_chunks.compare_exchange_weak(chunk->_next, chunk,
+                                                           std::memory_order_release,
+                                                           std::memory_order_relaxed)) {}
+            local._next = chunk->_entries;
+            local._end = chunk->_entries + CHUNK_SIZE;
+        }
+        geometry = local._next++;
+    }
+    this->_size.fetch_add(1, std::memory_order_relaxed);
+    return geometry;
+}
+
+void GeometryStore::release(Geometry *geometry) {
+    this->_size.fetch_sub(1, std::memory_order_relaxed);
+    Local &local = GeometryStore::local();
+    if (local._has_ended) {
+        Batch *batch = new Batch();
+        batch->_entries.push_back(geometry);
+        this->hand_over(batch);
+        return;
+    }
+    if (local._free == nullptr) {
+        local._free = new Batch();
+    }
+    std::vector<Geometry *> &entries = local._free->_entries;
+    entries.push_back(geometry);
+    if (entries.size() >= 2 * BATCH_SIZE) {
+        /* keep some entries for this thread and hand the rest to threads that allocate */
+        Batch *batch = new Batch();
+        batch->_entries.assign(entries.end() - BATCH_SIZE, entries.end());
+        entries.resize(entries.size() - BATCH_SIZE);
+        this->hand_over(batch);
+    }
+}
+
+size_t GeometryStore::size() const {
+    return this->_size.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,129 @@
+#include <gui/glyph_run_cache.h>
+
+using namespace SDL_GUI;
+
+std::map<SDL_Renderer *, std::vector<SDL_Texture *>> GlyphRunCache::_released;
+std::mutex GlyphRunCache::_released_mutex;
+
+GlyphRun::~GlyphRun() {
+    if (this->_textures.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(GlyphRunCache::_released_mutex);
+    for (auto &[renderer, texture]: this->_textures) {
+        GlyphRunCache::_released[renderer].push_back(texture);
+    }
+}
+
+SDL_Texture *GlyphRun::texture(SDL_Renderer *renderer) const {
+    if (this->_surface == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(this->_textures_mutex);
+    for (auto &[r, texture]: this->_textures) {
+        if (r == renderer) {
+            return texture;
+        }
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, this->_surface.get());
+    if (texture != nullptr) {
+        this->_textures.emplace_back(renderer, texture);
+    }
+    return texture;
+}
+
+GlyphRunCache::GlyphRunCache(TTF_Font *font, RGB color, size_t capacity)
+    : _font(font), _color(color), _capacity(capacity) {}
+
+std::shared_ptr<const GlyphRun> GlyphRunCache::render(std::string_view text) const {
+    GlyphRun *run = new GlyphRun();
+    std::string line(text);
+    SDL_Surface *rendered = line.empty() ? nullptr
+                            : TTF_RenderText_Blended(this->_font, line.c_str(), this->_color);
+    if (rendered == nullptr) {
+        return std::shared_ptr<const GlyphRun>(run);
+    }
+    /* same format as Text, so textures get created without conversion */
+    SDL_Surface *surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rendered);
+    if (surface == nullptr) {
+        return std::shared_ptr<const GlyphRun>(run);
+    }
+    run->_width = surface->w;
+    run->_height = surface->h;
+    run->_coverage.resize(surface->w * surface->h);
+    for (int y = 0; y < surface->h; ++y) {
+        const Uint32 *row = reinterpret_cast<const Uint32 *>(
+            static_cast<const Uint8 *>(surface->pixels) + y * surface->pitch);
+        for (int x = 0; x < surface->w; ++x) {
+            run->_coverage[y * surface->w + x] = row[x] >> 24;
+        }
+    }
+    run->_surface = std::shared_ptr<SDL_Surface>(surface, SDL_FreeSurface);
+    return std::shared_ptr<const GlyphRun>(run);
+}
+
+std::shared_ptr<const GlyphRun> GlyphRunCache::acquire(std::string_view text) {
+    std::shared_ptr<const GlyphRun> run = this->lookup(text);
+    if (run) {
+        return run;
+    }
+    /* rendering happens outside of the lock, so lookups of other threads do not wait for it */
+    run = this->render(text);
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(text);
+    if (it != this->_entries.end()) {
+        return it->second._run;
+    }
+    this->_lru.emplace_front(text);
+    this->_entries[this->_lru.front()] = {run, this->_lru.begin()};
+    while (this->_entries.size() > this->_capacity) {
+        this->_entries.erase(this->_lru.back());
+        this->_lru.pop_back();
+    }
+    return run;
+}
+
+std::shared_ptr<const GlyphRun> GlyphRunCache::lookup(std::string_view text) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(text);
+    if (it == this->_entries.end()) {
+        this->_misses++;
+        return nullptr;
+    }
+    this->_hits++;
+    this->_lru.splice(this->_lru.begin(), this->_lru, it->second._lru_position);
+    return it->second._run;
+}
+
+void GlyphRunCache::collect(SDL_Renderer *renderer) {
+    std::vector<SDL_Texture *> textures;
+    {
+        std::lock_guard<std::mutex> lock(GlyphRunCache::_released_mutex);
+        auto it = GlyphRunCache::_released.find(renderer);
+        if (it == GlyphRunCache::_released.end()) {
+            return;
+        }
+        textures.swap(it->second);
+        GlyphRunCache::_released.erase(it);
+    }
+    for (SDL_Texture *texture: textures) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+size_t GlyphRunCache::size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_entries.size();
+}
+
+unsigned long GlyphRunCache::hits() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_hits;
+}
+
+unsigned long GlyphRunCache::misses() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_misses;
+}
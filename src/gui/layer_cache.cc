@@ -0,0 +1,165 @@
+#include <gui/layer_cache.h>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace SDL_GUI;
+
+LayerCache::LayerCache(size_t budget) : _budget(budget) {}
+
+LayerCache::~LayerCache() {
+    for (const auto &[_, layer]: this->_layers) {
+        SDL_DestroyTexture(layer._texture);
+    }
+    this->destroy_released();
+}
+
+size_t LayerCache::bytes_of(int width, int height) {
+    /* layers are RGBA with 4 bytes per pixel */
+    return static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+}
+
+void LayerCache::destroy(std::map<const Drawable *, Layer>::iterator it) {
+    Layer &layer = it->second;
+    this->_released.push_back(layer._texture);
+    this->_bytes -= LayerCache::bytes_of(layer._width, layer._height);
+    this->_lru.erase(layer._lru_position);
+    this->_layers.erase(it);
+}
+
+bool LayerCache::is_pinned(const SDL_Texture *texture) const {
+    return std::find(this->_pinned.begin(), this->_pinned.end(), texture) != this->_pinned.end();
+}
+
+void LayerCache::destroy_released() {
+    /* pinned textures are still render targets and get destroyed after they got unpinned */
+    auto pinned = std::partition(this->_released.begin(), this->_released.end(),
+                                 [this](SDL_Texture *texture){
+                                     return not this->is_pinned(texture);
+                                 });
+    for (auto it = this->_released.begin(); it != pinned; ++it) {
+        SDL_DestroyTexture(*it);
+    }
+    this->_released.erase(this->_released.begin(), pinned);
+}
+
+void LayerCache::evict() {
+    auto it = this->_lru.end();
+    while (this->_bytes > this->_budget and it != this->_lru.begin()) {
+        auto layer = this->_layers.find(*std::prev(it));
+        if (this->is_pinned(layer->second._texture)) {
+            --it;
+            continue;
+        }
+        /* only the entry before it gets erased */
+        this->destroy(layer);
+    }
+}
+
+SDL_Texture *LayerCache::find(const Drawable *drawable) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_layers.find(drawable);
+    if (it == this->_layers.end() or not it->second._valid) {
+        return nullptr;
+    }
+    Layer &layer = it->second;
+    this->_lru.splice(this->_lru.begin(), this->_lru, layer._lru_position);
+    return layer._texture;
+}
+
+SDL_Texture *LayerCache::acquire(const Drawable *drawable, SDL_Renderer *renderer, int width,
+                                 int height) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->destroy_released();
+    auto it = this->_layers.find(drawable);
+    if (it != this->_layers.end()) {
+        Layer &layer = it->second;
+        if (layer._width == width and layer._height == height) {
+            layer._valid = true;
+            this->_lru.splice(this->_lru.begin(), this->_lru, layer._lru_position);
+            this->_pinned.push_back(layer._texture);
+            return layer._texture;
+        }
+        this->destroy(it);
+    }
+
+    if (not SDL_RenderTargetSupported(renderer)) {
+        return nullptr;
+    }
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET, width, height);
+    if (texture == nullptr) {
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    this->_lru.push_front(drawable);
+    Layer layer;
+    layer._texture = texture;
+    layer._width = width;
+    layer._height = height;
+    layer._valid = true;
+    layer._lru_position = this->_lru.begin();
+    this->_layers.emplace(drawable, layer);
+    this->_bytes += LayerCache::bytes_of(width, height);
+    this->_pinned.push_back(texture);
+
+    this->evict();
+    return texture;
+}
+
+void LayerCache::unpin(SDL_Texture *texture) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = std::find(this->_pinned.begin(), this->_pinned.end(), texture);
+    if (it != this->_pinned.end()) {
+        this->_pinned.erase(it);
+    }
+}
+
+void LayerCache::invalidate(const Drawable *drawable) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_layers.find(drawable);
+    if (it != this->_layers.end()) {
+        it->second._valid = false;
+    }
+}
+
+void LayerCache::invalidate_all() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    for (auto &[_, layer]: this->_layers) {
+        layer._valid = false;
+    }
+}
+
+void LayerCache::release(const Drawable *drawable) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_layers.find(drawable);
+    if (it != this->_layers.end()) {
+        this->destroy(it);
+    }
+}
+
+void LayerCache::collect() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->destroy_released();
+}
+
+size_t LayerCache::bytes() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_bytes;
+}
+
+size_t LayerCache::budget() const {
+    return this->_budget;
+}
+
+void LayerCache::set_budget(size_t budget) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_budget = budget;
+    this->evict();
+}
+
+size_t LayerCache::size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_layers.size();
+}
@@ -0,0 +1,101 @@
+#include <gui/mutation_queue.h>
+
+#include <gui/primitives/text.h>
+#include <gui/tree_transaction.h>
+
+using namespace SDL_GUI;
+
+MutationQueue::~MutationQueue() {
+    this->_queue.drain([](Mutation &&mutation){
+        delete mutation._child;
+    });
+}
+
+void MutationQueue::set_text(Handle target, std::string text) {
+    Mutation mutation{Type::SET_TEXT, target};
+    mutation._text = text;
+    this->_queue.push(std::move(mutation));
+}
+
+void MutationQueue::set_position(Handle target, Position position) {
+    Mutation mutation{Type::SET_POSITION, target};
+    mutation._position = position;
+    this->_queue.push(std::move(mutation));
+}
+
+void MutationQueue::add_child(Handle target, Drawable *child) {
+    Mutation mutation{Type::ADD_CHILD, target};
+    mutation._child = child;
+    this->_queue.push(std::move(mutation));
+}
+
+void MutationQueue::remove(Handle target) {
+    this->_queue.push(Mutation{Type::REMOVE, target});
+}
+
+void MutationQueue::set_style(Handle target, Style style) {
+    Mutation mutation{Type::SET_STYLE, target};
+    mutation._style = style;
+    this->_queue.push(std::move(mutation));
+}
+
+unsigned MutationQueue::apply() {
+    unsigned applied = 0;
+    TreeTransaction transaction;
+    this->_queue.drain([this, &applied](Mutation &&mutation){
+        if (this->apply_mutation(mutation)) {
+            applied++;
+        }
+    });
+    return applied;
+}
+
+bool MutationQueue::empty() const {
+    return this->_queue.empty();
+}
+
+bool MutationQueue::apply_mutation(Mutation &mutation) {
+    Drawable *target = Drawable::from_handle(mutation._target);
+    if (target == nullptr) {
+        delete mutation._child;
+        return false;
+    }
+
+    switch (mutation._type) {
+    case Type::SET_TEXT: {
+        Text *text = dynamic_cast<Text *>(target);
+        if (text == nullptr) {
+            return false;
+        }
+        text->set_text(mutation._text);
+        break;
+    }
+    case Type::SET_POSITION:
+        target->set_position(mutation._position);
+        break;
+    case Type::ADD_CHILD:
+        target->add_child(mutation._child);
+        break;
+    case Type::REMOVE:
+        if (target->parent() == nullptr) {
+            /* the root stays */
+            return false;
+        }
+        target->parent()->remove_children([target](Drawable *d){
+            return d == target;
+        });
+        break;
+    case Type::SET_STYLE:
+        target->_style = mutation._style;
+        /* showing and hiding has to notify the parent, e.g. to lay out a stack again */
+        target->_style._hidden = target->is_hidden();
+        if (mutation._style._hidden) {
+            target->hide();
+        } else {
+            target->show();
+        }
+        target->invalidate();
+        break;
+    }
+    return true;
+}
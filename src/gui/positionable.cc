@@ -3,116 +3,134 @@
 using namespace SDL_GUI;
 
 Positionable::Positionable(Position position, Position absolute_position, unsigned width,
-                           unsigned height) :
-    _position(position),
-    _absolute_position(absolute_position),
-    _width(width),
-    _height(height) {
+                           unsigned height) {
+    this->position_ref() = position;
+    this->absolute_position_ref() = absolute_position;
+    this->width_ref() = width;
+    this->height_ref() = height;
     this->init();
 }
 
+Positionable::Positionable(const Positionable &positionable) {
+    *this = positionable;
+}
+
+Positionable &Positionable::operator=(const Positionable &positionable) {
+    *this->_geometry = *positionable._geometry;
+    return *this;
+}
+
+Positionable::~Positionable() {
+    GeometryStore::instance()->release(this->_geometry);
+}
+
 void Positionable::init() {
-    this->_clip_rect = {this->_position._x, this->_position._y,
-                        static_cast<int>(this->_width), static_cast<int>(this->_height)};
+    Position position = this->position_ref();
+    this->clip_rect_ref() = {position._x, position._y, static_cast<int>(this->width_ref()),
+                             static_cast<int>(this->height_ref())};
 }
 
 
 void Positionable::set_position(Position position) {
-    Position diff = position - this->_position;
-    this->_position = position;
-    this->_absolute_position += diff;
+    Position diff = position - this->position_ref();
+    this->position_ref() = position;
+    this->absolute_position_ref() += diff;
     this->hook_post_move(diff);
 }
 
 void Positionable::set_absolute_position(Position position) {
-    this->_absolute_position = position;
+    this->absolute_position_ref() = position;
 }
 
 void Positionable::set_clip_rect(SDL_Rect clip_rect) {
-    this->_clip_rect = clip_rect;
+    this->clip_rect_ref() = clip_rect;
 }
 
 void Positionable::move(Position position) {
-    this->_position += position;
-    this->_absolute_position += position;
+    this->position_ref() += position;
+    this->absolute_position_ref() += position;
     this->hook_post_move(position);
 }
 
 void Positionable::move_absolute(Position position) {
-    this->_absolute_position += position;
+    this->absolute_position_ref() += position;
 }
 
 void Positionable::set_x(int x) {
-    int diff = x - this->_position._x;
-    this->_position._x = x;
-    this->_absolute_position._x += diff;
+    int diff = x - this->position_ref()._x;
+    this->position_ref()._x = x;
+    this->absolute_position_ref()._x += diff;
     this->hook_post_move({diff, 0});
 }
 
 void Positionable::set_absolute_x(int x) {
-    this->_absolute_position._x = x;
+    this->absolute_position_ref()._x = x;
 }
 
 void Positionable::set_y(int y) {
-    int diff = y - this->_position._y;
-    this->_position._y = y;
-    this->_absolute_position._y += diff;
+    int diff = y - this->position_ref()._y;
+    this->position_ref()._y = y;
+    this->absolute_position_ref()._y += diff;
     this->hook_post_move({0, diff});
 }
 
 void Positionable::set_absolute_y(int y) {
-    this->_absolute_position._y =y;
+    this->absolute_position_ref()._y =y;
 }
 
 void Positionable::set_width(unsigned width) {
-    this->_width = width;
+    this->width_ref() = width;
     this->hook_post_resize(width, 0);
 }
 
 void Positionable::set_height(unsigned height) {
-    this->_height = height;
+    this->height_ref() = height;
     this->hook_post_resize(0, height);
 }
 
 Position Positionable::position() const {
-    return this->_position;
+    return this->position_ref();
 }
 
 Position Positionable::absolute_position() const {
-    return this->_absolute_position;
+    this->resolve_geometry();
+    return this->absolute_position_ref();
 }
 
 SDL_Rect Positionable::clip_rect() const {
-    return this->_clip_rect;
+    this->resolve_geometry();
+    return this->clip_rect_ref();
 }
 
 int Positionable::x() const {
-    return this->_position._x;
+    return this->position_ref()._x;
 }
 
 int Positionable::y() const {
-    return this->_position._y;
+    return this->position_ref()._y;
 }
 
 unsigned Positionable::width() const {
-    return this->_width;
+    return this->width_ref();
 }
 
 unsigned Positionable::height() const {
-    return this->_height;
+    return this->height_ref();
 }
 
 
 bool Positionable::is_inside(Position position) const {
-    return position._x > this->_absolute_position._x &&
-           position._y > this->_absolute_position._y &&
-           position._x < this->_absolute_position._x + static_cast<int>(this->_width) &&
-           position._y < this->_absolute_position._y + static_cast<int>(this->_height);
+    Position absolute_position = this->absolute_position();
+    return position._x > absolute_position._x &&
+           position._y > absolute_position._y &&
+           position._x < absolute_position._x + static_cast<int>(this->width_ref()) &&
+           position._y < absolute_position._y + static_cast<int>(this->height_ref());
 }
 
 bool Positionable::is_inside_clip_rect(Position position) const {
-    return position._x > this->_clip_rect.x &&
-           position._y > this->_clip_rect.y &&
-           position._x < this->_clip_rect.x + static_cast<int>(this->_clip_rect.w) &&
-           position._y < this->_clip_rect.y + static_cast<int>(this->_clip_rect.h);
+    SDL_Rect clip_rect = this->clip_rect();
+    return position._x > clip_rect.x &&
+           position._y > clip_rect.y &&
+           position._x < clip_rect.x + static_cast<int>(clip_rect.w) &&
+           position._y < clip_rect.y + static_cast<int>(clip_rect.h);
 }
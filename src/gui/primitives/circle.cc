@@ -12,3 +12,9 @@ void Circle::draw(SDL_Renderer *renderer, Position position) const {
     const RGB &c = this->_style._color;
     aacircleRGBA(renderer, position._x, position._y, this->_radius, c._r, c._g, c._b, c._a);
 }
+
+SDL_Rect Circle::draw_bounds(Position position) const {
+    /* position is the center. Antialiasing exceeds the radius by one pixel. */
+    int radius = this->_radius + 1;
+    return {position._x - radius, position._y - radius, 2 * radius + 1, 2 * radius + 1};
+}
@@ -0,0 +1,386 @@
+#include <gui/primitives/data_grid.h>
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+
+#include <gui/blend.h>
+
+using namespace SDL_GUI;
+
+/** space between the left border of a cell and its text */
+static const int CELL_PADDING = 4;
+
+/**
+ * compute the displayed rows of a table
+ * @param data cells of table
+ * @param sort_column column to sort by. SIZE_MAX if unsorted
+ * @param ascending flag that determines the sort direction
+ * @param filter_column column to filter by. SIZE_MAX if unfiltered
+ * @param filter_text text the cells of filter_column have to contain
+ * @return indices of displayed rows in order
+ */
+static std::vector<uint32_t> *compute_order(const ColumnStore &data, size_t sort_column,
+                                            bool ascending, size_t filter_column,
+                                            const std::string &filter_text) {
+    std::vector<uint32_t> *order = new std::vector<uint32_t>();
+    order->reserve(filter_column == SIZE_MAX ? data.rows() : 0);
+    for (size_t row = 0; row < data.rows(); ++row) {
+        if (filter_column == SIZE_MAX
+            or data.cell(row, filter_column).find(filter_text) != std::string_view::npos) {
+            order->push_back(static_cast<uint32_t>(row));
+        }
+    }
+    if (sort_column == SIZE_MAX) {
+        return order;
+    }
+
+    /* numbers sort by value. Otherwise 10 would come before 9. */
+    std::vector<double> keys(data.rows());
+    bool is_numeric = true;
+    for (uint32_t row: *order) {
+        std::string_view cell = data.cell(row, sort_column);
+        std::from_chars_result result = std::from_chars(cell.data(), cell.data() + cell.size(),
+                                                        keys[row]);
+        if (cell.empty() or result.ec != std::errc() or result.ptr != cell.data() + cell.size()) {
+            is_numeric = false;
+            break;
+        }
+    }
+    if (is_numeric) {
+        std::stable_sort(order->begin(), order->end(), [&keys, ascending](uint32_t a, uint32_t b){
+            return ascending ? keys[a] < keys[b] : keys[b] < keys[a];
+        });
+    } else {
+        std::stable_sort(order->begin(), order->end(),
+            [&data, sort_column, ascending](uint32_t a, uint32_t b){
+                std::string_view cell_a = data.cell(a, sort_column);
+                std::string_view cell_b = data.cell(b, sort_column);
+                return ascending ? cell_a < cell_b : cell_b < cell_a;
+            });
+    }
+    return order;
+}
+
+DataGrid::DataGrid(TTF_Font *font, std::shared_ptr<const ColumnStore> data, Position position,
+                   unsigned width, unsigned height, unsigned column_width, unsigned row_height)
+    : Rect("DataGrid", position, width, height), _data(data),
+      _column_widths(data ? data->columns() : 0, column_width), _row_height(row_height),
+      _glyph_runs(std::make_shared<GlyphRunCache>(font, RGB(0, 0, 0))) {
+    if (this->_row_height == 0) {
+        this->_row_height = TTF_FontLineSkip(font) + CELL_PADDING;
+    }
+    this->enable_scrolling();
+    this->set_enforcing_limits(true);
+    this->update_scroll_limits();
+}
+
+DataGrid::DataGrid(const DataGrid &grid)
+    : Rect(grid), _data(grid._data), _order(grid._order), _column_widths(grid._column_widths),
+      _row_height(grid._row_height), _glyph_runs(grid._glyph_runs),
+      _sort_column(grid._sort_column), _ascending(grid._ascending),
+      _filter_column(grid._filter_column), _filter_text(grid._filter_text) {}
+
+DataGrid::~DataGrid() {
+    delete this->_workers;
+}
+
+Drawable *DataGrid::clone() const {
+    return new DataGrid(*this);
+}
+
+void DataGrid::update_scroll_limits() {
+    unsigned long content_width = 0;
+    for (unsigned width: this->_column_widths) {
+        content_width += width;
+    }
+    unsigned long content_height = this->displayed_rows() * this->_row_height;
+    unsigned long body_height = this->height_ref() > this->_row_height
+                                ? this->height_ref() - this->_row_height : 0;
+
+    /* childs would get shifted by the scroll position, so scrolling down is negative */
+    unsigned long overflow_x = content_width > this->width_ref()
+                               ? content_width - this->width_ref() : 0;
+    unsigned long overflow_y = content_height > body_height ? content_height - body_height : 0;
+    Position min = {-static_cast<int>(std::min(overflow_x, static_cast<unsigned long>(INT_MAX))),
+                    -static_cast<int>(std::min(overflow_y, static_cast<unsigned long>(INT_MAX)))};
+    this->set_min_limit(min);
+    this->set_max_limit({0, 0});
+    this->set_scroll_position({std::max(this->_scroll_position._x, min._x),
+                               std::max(this->_scroll_position._y, min._y)});
+}
+
+void DataGrid::request_order() {
+    bool is_unordered = this->_sort_column == SIZE_MAX and this->_filter_column == SIZE_MAX;
+    unsigned long query;
+    {
+        std::lock_guard<std::mutex> lock(this->_pending_mutex);
+        query = ++this->_query;
+        if (is_unordered) {
+            this->_pending_order = nullptr;
+            this->_pending_query = query;
+        }
+    }
+    if (is_unordered) {
+        /* all rows in the order of the data need no worker */
+        this->_order = nullptr;
+        this->update_scroll_limits();
+        this->_runs_outdated = true;
+        this->invalidate();
+        return;
+    }
+    if (this->_workers == nullptr) {
+        this->_workers = new ThreadPool(1);
+    }
+    std::shared_ptr<const ColumnStore> data = this->_data;
+    size_t sort_column = this->_sort_column;
+    bool ascending = this->_ascending;
+    size_t filter_column = this->_filter_column;
+    std::string filter_text = this->_filter_text;
+    this->_workers->enqueue([this, data, sort_column, ascending, filter_column, filter_text,
+                             query](){
+        {
+            std::lock_guard<std::mutex> lock(this->_pending_mutex);
+            if (query != this->_query) {
+                return;
+            }
+        }
+        std::shared_ptr<const RowOrder> order(compute_order(*data, sort_column, ascending,
+                                                            filter_column, filter_text));
+        std::lock_guard<std::mutex> lock(this->_pending_mutex);
+        if (query == this->_query) {
+            this->_pending_order = order;
+            this->_pending_query = query;
+        }
+    });
+}
+
+void DataGrid::visible_rows(size_t *first, size_t *last) const {
+    unsigned long top = static_cast<unsigned long>(std::max(0, -this->_scroll_position._y));
+    unsigned long body_height = this->height_ref() > this->_row_height
+                                ? this->height_ref() - this->_row_height : 0;
+    size_t displayed_rows = this->displayed_rows();
+    *first = std::min(static_cast<size_t>(top / this->_row_height), displayed_rows);
+    *last = std::min(static_cast<size_t>((top + body_height) / this->_row_height + 1),
+                     displayed_rows);
+}
+
+void DataGrid::visible_columns(size_t *first, size_t *last, int *x) const {
+    int left = std::max(0, -this->_scroll_position._x);
+    int right = left + static_cast<int>(this->width_ref());
+    int start = 0;
+    *first = this->_column_widths.size();
+    *last = this->_column_widths.size();
+    *x = 0;
+    for (size_t column = 0; column < this->_column_widths.size(); ++column) {
+        int end = start + static_cast<int>(this->_column_widths[column]);
+        if (*first == this->_column_widths.size() and end > left) {
+            *first = column;
+            *x = start - left;
+        }
+        if (start >= right) {
+            *last = column;
+            break;
+        }
+        start = end;
+    }
+}
+
+void DataGrid::hook_post_scroll(Position scroll_offset) {
+    Drawable::hook_post_scroll(scroll_offset);
+    this->_runs_outdated = true;
+}
+
+void DataGrid::hook_post_resize(unsigned width, unsigned height) {
+    Drawable::hook_post_resize(width, height);
+    this->update_scroll_limits();
+    this->_runs_outdated = true;
+}
+
+void DataGrid::set_data(std::shared_ptr<const ColumnStore> data) {
+    this->_data = data;
+    this->_column_widths.resize(data ? data->columns() : 0, 100);
+    /* the previous order refers to rows of the previous data */
+    this->_order = nullptr;
+    size_t columns = data ? data->columns() : 0;
+    if (this->_sort_column >= columns) {
+        this->_sort_column = SIZE_MAX;
+    }
+    if (this->_filter_column >= columns) {
+        this->_filter_column = SIZE_MAX;
+    }
+    this->request_order();
+    this->update_scroll_limits();
+    this->_runs_outdated = true;
+    this->invalidate();
+}
+
+std::shared_ptr<const ColumnStore> DataGrid::data() const {
+    return this->_data;
+}
+
+size_t DataGrid::displayed_rows() const {
+    if (this->_order) {
+        return this->_order->size();
+    }
+    return this->_data ? this->_data->rows() : 0;
+}
+
+void DataGrid::set_column_width(size_t column, unsigned width) {
+    if (column >= this->_column_widths.size()) {
+        return;
+    }
+    this->_column_widths[column] = width;
+    this->update_scroll_limits();
+    this->_runs_outdated = true;
+    this->invalidate();
+}
+
+void DataGrid::sort(size_t column, bool ascending) {
+    this->_sort_column = this->_data and column < this->_data->columns() ? column : SIZE_MAX;
+    this->_ascending = ascending;
+    this->request_order();
+}
+
+void DataGrid::filter(size_t column, std::string text) {
+    bool is_valid = this->_data and column < this->_data->columns() and not text.empty();
+    this->_filter_column = is_valid ? column : SIZE_MAX;
+    this->_filter_text = text;
+    this->request_order();
+}
+
+bool DataGrid::is_pending() {
+    std::lock_guard<std::mutex> lock(this->_pending_mutex);
+    return this->_pending_query != this->_query or this->_pending_order != nullptr;
+}
+
+void DataGrid::wait() {
+    if (this->_workers) {
+        this->_workers->wait();
+    }
+}
+
+const GlyphRunCache *DataGrid::glyph_runs() const {
+    return this->_glyph_runs.get();
+}
+
+void DataGrid::update() {
+    std::shared_ptr<const RowOrder> order;
+    {
+        std::lock_guard<std::mutex> lock(this->_pending_mutex);
+        order.swap(this->_pending_order);
+    }
+    if (order) {
+        this->_order = order;
+        this->update_scroll_limits();
+        this->_runs_outdated = true;
+        this->invalidate();
+    }
+
+    if (not this->_runs_outdated or not this->_data) {
+        return;
+    }
+    size_t first_column;
+    size_t last_column;
+    int x;
+    this->visible_columns(&first_column, &last_column, &x);
+    size_t first_row;
+    size_t last_row;
+    this->visible_rows(&first_row, &last_row);
+    for (size_t column = first_column; column < last_column; ++column) {
+        this->_glyph_runs->acquire(this->_data->name(column));
+        for (size_t i = first_row; i < last_row; ++i) {
+            size_t row = this->_order ? (*this->_order)[i] : i;
+            this->_glyph_runs->acquire(this->_data->cell(row, column));
+        }
+    }
+    this->_runs_outdated = false;
+}
+
+void DataGrid::draw_cell(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Rect area,
+                         SDL_Rect cell, std::string_view text) const {
+    SDL_Rect visible;
+    if (not SDL_IntersectRect(&cell, &area, &visible)) {
+        return;
+    }
+    std::shared_ptr<const GlyphRun> run = this->_glyph_runs->lookup(text);
+    if (run == nullptr or run->_surface == nullptr) {
+        return;
+    }
+    int x = cell.x + CELL_PADDING;
+    int y = cell.y + (cell.h - run->_height) / 2;
+    /* texts get cut off at the border of their cell */
+    if (surface) {
+        SDL_SetClipRect(surface, &visible);
+        blend::blit_a8_surface(run->_coverage.data(), run->_width, run->_height, surface, x, y,
+                               RGB(0, 0, 0));
+        return;
+    }
+    SDL_Texture *texture = run->texture(renderer);
+    if (texture == nullptr) {
+        return;
+    }
+    SDL_RenderSetClipRect(renderer, &visible);
+    SDL_Rect destination = {x, y, run->_width, run->_height};
+    SDL_RenderCopy(renderer, texture, nullptr, &destination);
+}
+
+void DataGrid::draw(SDL_Renderer *renderer, Position position) const {
+    Rect::draw(renderer, position);
+    if (not this->_data) {
+        return;
+    }
+    SDL_Rect clip_rect;
+    SDL_RenderGetClipRect(renderer, &clip_rect);
+    SDL_Rect area = {position._x, position._y, static_cast<int>(this->width_ref()),
+                     static_cast<int>(this->height_ref())};
+    if (not SDL_RectEmpty(&clip_rect) and not SDL_IntersectRect(&area, &clip_rect, &area)) {
+        return;
+    }
+    SDL_Surface *surface = blend::target_of(renderer);
+    if (surface == nullptr) {
+        /* texts that scrolled out of the cache do not keep their textures */
+        GlyphRunCache::collect(renderer);
+    }
+    int row_height = static_cast<int>(this->_row_height);
+
+    size_t first_column;
+    size_t last_column;
+    int first_x;
+    this->visible_columns(&first_column, &last_column, &first_x);
+
+    /* the header stays on top when scrolling down */
+    int x = position._x + first_x;
+    for (size_t column = first_column; column < last_column; ++column) {
+        int width = static_cast<int>(this->_column_widths[column]);
+        this->draw_cell(renderer, surface, area, {x, position._y, width, row_height},
+                        this->_data->name(column));
+        x += width;
+    }
+
+    SDL_Rect body = {area.x, std::max(area.y, position._y + row_height), area.w,
+                     area.y + area.h - std::max(area.y, position._y + row_height)};
+    size_t first_row;
+    size_t last_row;
+    this->visible_rows(&first_row, &last_row);
+    int top = std::max(0, -this->_scroll_position._y);
+    int y = position._y + row_height + static_cast<int>(first_row) * row_height - top;
+    for (size_t i = first_row; i < last_row; ++i) {
+        size_t row = this->_order ? (*this->_order)[i] : i;
+        x = position._x + first_x;
+        for (size_t column = first_column; column < last_column; ++column) {
+            int width = static_cast<int>(this->_column_widths[column]);
+            this->draw_cell(renderer, surface, body, {x, y, width, row_height},
+                            this->_data->cell(row, column));
+            x += width;
+        }
+        y += row_height;
+    }
+
+    const SDL_Rect *previous_clip_rect = SDL_RectEmpty(&clip_rect) ? nullptr : &clip_rect;
+    if (surface) {
+        SDL_SetClipRect(surface, previous_clip_rect);
+    } else {
+        SDL_RenderSetClipRect(renderer, previous_clip_rect);
+    }
+}
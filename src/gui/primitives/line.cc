@@ -2,6 +2,8 @@
 
 #include <SDL2_gfx/SDL2_gfxPrimitives.h>
 
+#include <gui/util.h>
+
 using namespace SDL_GUI;
 
 Line::Line(Position begin, Position end)
@@ -14,9 +16,9 @@ void Line::update_dimensions() {
     int max_x = std::max(this->_begin._x, this->_end._x);
     int min_y = std::min(this->_begin._y, this->_end._y);
     int max_y = std::max(this->_begin._y, this->_end._y);
-    this->_position = Position(min_x, min_y);
-    this->_width = max_x - min_x;
-    this->_height = max_y - min_y;
+    this->position_ref() = Position(min_x, min_y);
+    this->width_ref() = max_x - min_x;
+    this->height_ref() = max_y - min_y;
 }
 
 Drawable *Line::clone() const {
@@ -24,7 +26,7 @@ Drawable *Line::clone() const {
 }
 
 void Line::draw(SDL_Renderer *renderer, Position position) const {
-    position -= this->_position;
+    position -= this->position_ref();
     Position begin = this->_begin + position;
     Position end = this->_end + position;
     const RGB &c = this->_style._color;
@@ -32,11 +34,20 @@ void Line::draw(SDL_Renderer *renderer, Position position) const {
         aalineRGBA(renderer, begin._x, begin._y, end._x, end._y,
                    c._r, c._g, c._b, c._a);
     } else {
-        thickLineRGBA(renderer, begin._x, begin._y, end._x, end._y, this->_line_width,
-                      c._r, c._g, c._b, c._a);
+        util::thick_line_RGBA(renderer, begin._x, begin._y, end._x, end._y, this->_line_width,
+                              c._r, c._g, c._b, c._a);
     }
 }
 
+SDL_Rect Line::draw_bounds(Position position) const {
+    /* position is the top left corner of the lines bounding box. Thick and antialiased lines
+     * exceed it. */
+    int margin = this->_line_width / 2 + 1;
+    return {position._x - margin, position._y - margin,
+            static_cast<int>(this->width_ref()) + 2 * margin + 1,
+            static_cast<int>(this->height_ref()) + 2 * margin + 1};
+}
+
 void Line::set_end(Position position) {
     this->_end = position;
     this->update_dimensions();
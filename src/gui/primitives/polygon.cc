@@ -1,7 +1,11 @@
 #include <gui/primitives/polygon.h>
 
+#include <algorithm>
+
 #include <SDL2_gfx/SDL2_gfxPrimitives.h>
 
+#include <gui/util.h>
+
 using namespace SDL_GUI;
 
 Drawable *Polygon::clone() const {
@@ -42,7 +46,7 @@ void Polygon::draw(SDL_Renderer *renderer, Position position) const {
         ++i;
     }
     const RGB &c = this->_style._color;
-    filledPolygonRGBA(renderer, xs, ys, size, c._r, c._g, c._b, c._a);
+    util::filled_polygon_RGBA(renderer, xs, ys, size, c._r, c._g, c._b, c._a);
     delete[] xs;
     delete[] ys;
 }
@@ -62,9 +66,25 @@ void Polygon::draw_border(SDL_Renderer *renderer, Position position) const {
             aalineRGBA(renderer, begin._x, begin._y, end._x, end._y,
                     c._r, c._g, c._b, c._a);
         } else {
-            thickLineRGBA(renderer, begin._x, begin._y, end._x, end._y, this->_line_width,
-                        c._r, c._g, c._b, c._a);
+            util::thick_line_RGBA(renderer, begin._x, begin._y, end._x, end._y, this->_line_width,
+                                  c._r, c._g, c._b, c._a);
         }
         begin = end;
     }
 }
+
+SDL_Rect Polygon::draw_bounds(Position position) const {
+    if (this->_points.empty()) {
+        return {position._x, position._y, 0, 0};
+    }
+    Position min = this->_points.front();
+    Position max = this->_points.front();
+    for (const Position &point: this->_points) {
+        min = {std::min(min._x, point._x), std::min(min._y, point._y)};
+        max = {std::max(max._x, point._x), std::max(max._y, point._y)};
+    }
+    /* thick and antialiased borders exceed the points */
+    int margin = this->_line_width / 2 + 1;
+    return {position._x + min._x - margin, position._y + min._y - margin,
+            max._x - min._x + 2 * margin + 1, max._y - min._y + 2 * margin + 1};
+}
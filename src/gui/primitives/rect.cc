@@ -2,12 +2,14 @@
 
 #include <SDL2_gfx/SDL2_gfxPrimitives.h>
 
+#include <gui/blend.h>
+
 using namespace SDL_GUI;
 
 Rect::Rect(std::string type, Position position, unsigned width, unsigned height)
     : Drawable(type, position) {
-    this->_width = width;
-    this->_height = height;
+    this->width_ref() = width;
+    this->height_ref() = height;
 }
 
 Drawable *Rect::clone() const {
@@ -18,9 +20,21 @@ void Rect::draw(SDL_Renderer *renderer, Position position) const {
 
     if (this->_style._has_background) {
         const RGB &c = this->_style._color;
+        SDL_Surface *surface = blend::target_of(renderer);
+        if (surface != nullptr) {
+            blend::fill_rect(surface, {position._x, position._y,
+                                       static_cast<int>(this->width_ref()),
+                                       static_cast<int>(this->height_ref())}, c);
+            return;
+        }
         this->_style._color.activate(renderer);
         boxRGBA(renderer, position._x, position._y,
-                position._x + this->_width - 1, position._y + this->_height - 1,
+                position._x + this->width_ref() - 1, position._y + this->height_ref() - 1,
                 c._r, c._g, c._b, c._a);
     }
 }
+
+bool Rect::is_opaque() const {
+    return this->_style._has_background and this->_style._color._a == 255
+           and this->width_ref() > 0 and this->height_ref() > 0;
+}
@@ -0,0 +1,107 @@
+#include <gui/primitives/stack.h>
+
+#include <algorithm>
+
+using namespace SDL_GUI;
+
+Stack::Stack(Direction direction, Position position)
+    : Rect("Stack", position), _direction(direction) {}
+
+Drawable *Stack::clone() const {
+    return new Stack(*this);
+}
+
+void Stack::hook_post_child_change(Drawable *child) {
+    (void) child;
+    this->request_layout();
+}
+
+void Stack::layout() {
+    bool is_vertical = this->_direction == Direction::VERTICAL;
+    int padding = static_cast<int>(this->_padding);
+
+    /* the cross size is needed to align children before any of them can be placed */
+    unsigned cross_size = 0;
+    for (const Drawable *child: this->children_ref()) {
+        if (not child->is_hidden()) {
+            cross_size = std::max(cross_size, is_vertical ? child->width() : child->height());
+        }
+    }
+
+    int main = padding;
+    bool is_first = true;
+    for (Drawable *child: this->children_ref()) {
+        if (child->is_hidden()) {
+            continue;
+        }
+        if (not is_first) {
+            main += this->_spacing;
+        }
+        is_first = false;
+
+        unsigned child_cross = is_vertical ? child->width() : child->height();
+        int cross = padding;
+        switch (this->_alignment) {
+            case Alignment::START:
+                break;
+            case Alignment::CENTER:
+                cross += (cross_size - child_cross) / 2;
+                break;
+            case Alignment::END:
+                cross += cross_size - child_cross;
+                break;
+        }
+        Position position = is_vertical ? Position(cross, main) : Position(main, cross);
+        /* moving invalidates geometry and cached layers. Only do it on actual changes. */
+        if (not (position == child->position())) {
+            child->set_position(position);
+        }
+        main += is_vertical ? child->height() : child->width();
+    }
+
+    unsigned main_size = main + padding;
+    unsigned width = is_vertical ? cross_size + 2 * padding : main_size;
+    unsigned height = is_vertical ? main_size : cross_size + 2 * padding;
+    if (width != this->width_ref()) {
+        this->set_width(width);
+    }
+    if (height != this->height_ref()) {
+        this->set_height(height);
+    }
+}
+
+Stack::Direction Stack::direction() const {
+    return this->_direction;
+}
+
+void Stack::set_direction(Direction direction) {
+    this->_direction = direction;
+    this->request_layout();
+}
+
+Stack::Alignment Stack::alignment() const {
+    return this->_alignment;
+}
+
+void Stack::set_alignment(Alignment alignment) {
+    this->_alignment = alignment;
+    this->request_layout();
+}
+
+unsigned Stack::spacing() const {
+    return this->_spacing;
+}
+
+void Stack::set_spacing(unsigned spacing) {
+    this->_spacing = spacing;
+    this->request_layout();
+}
+
+unsigned Stack::padding() const {
+    return this->_padding;
+}
+
+void Stack::set_padding(unsigned padding) {
+    this->_padding = padding;
+    this->request_layout();
+}
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include <gui/blend.h>
 #include <util/string.h>
 
 using namespace SDL_GUI;
@@ -11,85 +12,95 @@ Text::Text(TTF_Font *font, const std::string text, Position position)
     this->create_surfaces();
 }
 
-Text::~Text() {
-    for (SDL_Surface *s: this->_surfaces) {
-        SDL_FreeSurface(s);
-    }
-    if (this->_surface != nullptr) {
-        SDL_FreeSurface(this->_surface);
-    }
-}
-
 Drawable *Text::clone() const {
-    return new Text(this->_font, this->_text, this->_position);
+    return new Text(*this);
 }
 
 void Text::create_surfaces() {
-    for (SDL_Surface *s: this->_surfaces) {
-        SDL_FreeSurface(s);
-    }
-    this->_surfaces.clear();
-    if (this->_surface != nullptr) {
-        SDL_FreeSurface(this->_surface);
-    }
-
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-    Uint32 rmask = 0xff000000;
-    Uint32 gmask = 0x00ff0000;
-    Uint32 bmask = 0x0000ff00;
-    Uint32 amask = 0x000000ff;
-#else
-    Uint32 rmask = 0x000000ff;
-    Uint32 gmask = 0x0000ff00;
-    Uint32 bmask = 0x00ff0000;
-    Uint32 amask = 0xff000000;
-#endif
-
+    std::vector<SDL_Surface *> surfaces;
     std::vector<std::string> lines = split_string(this->_text, "\n");
+    int width = 0;
     for (std::string line: lines) {
         SDL_Surface *s = TTF_RenderText_Blended(this->_font, line.c_str(),
                                                 this->_style._color);
         if (s == nullptr) {
             continue;
         }
-        this->_surfaces.push_back(s);
+        surfaces.push_back(s);
+        width = std::max(width, s->w);
     }
 
-    this->_surface = SDL_CreateRGBSurface(0, this->width(), this->height(), 32, rmask, gmask, bmask, amask);
-
+    /* ARGB8888 is what the renderers use natively. Creating a texture from it then only copies the
+     * pixels instead of converting, which keeps drawing from multiple threads read only. */
     int lineskip = TTF_FontLineSkip(this->_font);
-    SDL_Rect dstrect = {0,0,0,0};
-    for (SDL_Surface *s: this->_surfaces) {
-        SDL_BlitSurface(s, NULL, this->_surface, &dstrect);
-        dstrect.y += lineskip;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, surfaces.size() * lineskip,
+                                                          32, SDL_PIXELFORMAT_ARGB8888);
+    int y = 0;
+    for (SDL_Surface *s: surfaces) {
+        blend::blit_surface(s, surface, 0, y);
+        y += lineskip;
+        SDL_FreeSurface(s);
     }
+
+    this->_surface = std::shared_ptr<SDL_Surface>(surface, SDL_FreeSurface);
+    this->_coverage = std::make_shared<Coverage>();
+}
+
+const std::vector<Uint8> &Text::coverage() const {
+    /* the glyphs are in a single color. Drawing directly onto a surface only needs their
+     * coverage. */
+    std::call_once(this->_coverage->_once, [this](){
+            const SDL_Surface *surface = this->_surface.get();
+            std::vector<Uint8> &alpha = this->_coverage->_alpha;
+            alpha.resize(surface->w * surface->h);
+            for (int y = 0; y < surface->h; ++y) {
+                const Uint32 *row = reinterpret_cast<const Uint32 *>(
+                    static_cast<const Uint8 *>(surface->pixels) + y * surface->pitch);
+                for (int x = 0; x < surface->w; ++x) {
+                    alpha[y * surface->w + x] = row[x] >> 24;
+                }
+            }
+        });
+    return this->_coverage->_alpha;
 }
 
 void Text::draw(SDL_Renderer *renderer, Position position) const {
+    SDL_Surface *surface = blend::target_of(renderer);
+    if (surface != nullptr) {
+        const RGB &c = this->_style._color;
+        /* the color alpha is already part of the coverage */
+        blend::blit_a8_surface(this->coverage().data(), this->_surface->w, this->_surface->h,
+                               surface, position._x, position._y, RGB(c._r, c._g, c._b));
+        return;
+    }
     SDL_Rect dstrect{position._x, position._y, this->_surface->w, this->_surface->h};
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, this->_surface);
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, this->_surface.get());
     SDL_RenderCopy(renderer, texture, NULL, &dstrect);
     SDL_DestroyTexture(texture);
 }
 
 void Text::set_text(const std::string text) {
+    unsigned width = this->width();
+    unsigned height = this->height();
     this->_text = text;
     this->create_surfaces();
+    this->invalidate();
+    /* layouts only need to know about changed sizes */
+    if (this->width() != width or this->height() != height) {
+        this->hook_post_resize(this->width(), this->height());
+    }
 }
 
 void Text::set_color(RGB color) {
     this->_style._color = color;
     this->create_surfaces();
+    this->invalidate();
 }
 
 unsigned Text::height() const {
-    return this->_surfaces.size() * TTF_FontLineSkip(this->_font);
+    return this->_surface->h;
 }
 
 unsigned Text::width() const {
-    unsigned width = 0;
-    for (SDL_Surface *s: this->_surfaces) {
-        width = std::max(width, static_cast<unsigned>(s->w));
-    }
-    return width;
+    return this->_surface->w;
 }
@@ -1,16 +1,36 @@
 #include <gui/primitives/texture.h>
 
-#include <SDL2/SDL_image.h>
+#include <SDL2_gfx/SDL2_gfxPrimitives.h>
+
+#include <gui/blend.h>
 
 using namespace SDL_GUI;
-std::map<std::string, SDL_Texture *> Texture::_textures;
+
+/** color of the placeholder that gets drawn while an image is loading */
+static const RGB PLACEHOLDER_COLOR = RGB(200, 200, 200, 255);
 
 Texture::Texture(std::string type, std::string path, SDL_Renderer *renderer)
-    : Drawable(type), _path(path) {
-    if (!Texture::_textures.contains(path)) {
-        Texture::_textures.insert({path, IMG_LoadTexture(renderer, this->_path.c_str())});
-    }
-    this->_texture = Texture::_textures[path];
+    : Drawable(type), _path(path), _renderer(renderer) {
+    this->_cache = TextureCache::of(renderer);
+    this->_entry = this->_cache->acquire(path);
+}
+
+Texture::Texture(const Texture &texture)
+    : Drawable(texture), _path(texture._path), _renderer(texture._renderer),
+      _cache(texture._cache) {
+    this->_entry = this->_cache->acquire(this->_path);
+}
+
+Texture::~Texture() {
+    this->_cache->release(this->_path);
+}
+
+bool Texture::upload_decoded(SDL_Renderer *renderer, size_t budget) {
+    return TextureCache::of(renderer)->upload_decoded(renderer, budget);
+}
+
+void Texture::destroy_textures(SDL_Renderer *renderer) {
+    TextureCache::destroy(renderer);
 }
 
 Drawable *Texture::clone() const {
@@ -21,8 +41,38 @@ void Texture::draw(SDL_Renderer *renderer, Position position) const {
     SDL_Rect rect = {
         position._x,
         position._y,
-        static_cast<int>(this->_width),
-        static_cast<int>(this->_height),
+        static_cast<int>(this->width_ref()),
+        static_cast<int>(this->height_ref()),
     };
-    SDL_RenderCopy(renderer, this->_texture, NULL, &rect);
+    TextureCache *cache = this->_cache;
+    TextureEntry *entry = this->_entry;
+    /* tiles get rendered with their own renderers, which can not use textures of _renderer */
+    if (renderer != this->_renderer) {
+        cache = TextureCache::of(renderer);
+        entry = cache->lookup(this->_path);
+    }
+    const TextureRegion *region = cache->find(renderer, entry, rect.w, rect.h);
+    if (region == nullptr) {
+        const RGB &c = PLACEHOLDER_COLOR;
+        SDL_Surface *surface = blend::target_of(renderer);
+        if (surface != nullptr) {
+            blend::fill_rect(surface, rect, c);
+            return;
+        }
+        boxRGBA(renderer, rect.x, rect.y, rect.x + rect.w - 1, rect.y + rect.h - 1,
+                c._r, c._g, c._b, c._a);
+        return;
+    }
+    /* images of surface caches get blended onto the target surface */
+    if (region->_surface != nullptr) {
+        SDL_Surface *surface = blend::target_of(renderer);
+        if (surface != nullptr) {
+            blend::blit_scaled_surface(region->_surface, surface, rect);
+        }
+        return;
+    }
+    if (region->_texture == nullptr) {
+        return;
+    }
+    SDL_RenderCopy(renderer, region->_texture, &region->_rect, &rect);
 }
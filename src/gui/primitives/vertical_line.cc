@@ -8,5 +8,6 @@ Drawable *VerticalLine::clone() const {
 
 void VerticalLine::draw(SDL_Renderer *renderer, Position position) const {
     this->_style._color.activate(renderer);
-    SDL_RenderDrawLine(renderer, position._x, position._y, position._x, position._y + this->_height);
+    SDL_RenderDrawLine(renderer, position._x, position._y, position._x,
+                       position._y + this->height_ref());
 }
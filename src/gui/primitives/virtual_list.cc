@@ -0,0 +1,163 @@
+#include <gui/primitives/virtual_list.h>
+
+#include <algorithm>
+#include <climits>
+
+#include <gui/tree_transaction.h>
+
+using namespace SDL_GUI;
+
+VirtualList::VirtualList(Position position, unsigned width, unsigned height, size_t row_count,
+                         unsigned row_height, RowFactory create_row, RowBinder bind_row,
+                         unsigned overscan)
+    : Rect("VirtualList", position, width, height), _row_count(row_count),
+      _row_height(std::max(row_height, 1u)), _overscan(overscan), _create_row(create_row),
+      _bind_row(bind_row) {
+    this->enable_scrolling_y();
+    this->set_enforcing_limits(true);
+    this->update_row_offsets();
+    this->update_scroll_limits();
+    this->update_rows();
+}
+
+VirtualList::VirtualList(Position position, unsigned width, unsigned height, size_t row_count,
+                         RowHeightProvider row_height_provider, RowFactory create_row,
+                         RowBinder bind_row, unsigned overscan)
+    : Rect("VirtualList", position, width, height), _row_count(row_count), _row_height(0),
+      _row_height_provider(row_height_provider), _overscan(overscan), _create_row(create_row),
+      _bind_row(bind_row) {
+    this->enable_scrolling_y();
+    this->set_enforcing_limits(true);
+    this->update_row_offsets();
+    this->update_scroll_limits();
+    this->update_rows();
+}
+
+Drawable *VirtualList::clone() const {
+    /* the copied rows are not managed by a list */
+    return new Rect(*this);
+}
+
+void VirtualList::update_row_offsets() {
+    if (this->_row_height != 0) {
+        return;
+    }
+    this->_row_offsets.resize(this->_row_count + 1);
+    unsigned long offset = 0;
+    for (size_t row = 0; row < this->_row_count; ++row) {
+        this->_row_offsets[row] = offset;
+        offset += this->_row_height_provider(row);
+    }
+    this->_row_offsets[this->_row_count] = offset;
+}
+
+void VirtualList::update_scroll_limits() {
+    /* childs get shifted by the scroll position, so scrolling down is negative */
+    unsigned long content_height = this->content_height();
+    unsigned long overflow = content_height > this->height_ref()
+                             ? content_height - this->height_ref() : 0;
+    int min_y = -static_cast<int>(std::min(overflow, static_cast<unsigned long>(INT_MAX)));
+    this->set_min_limit({0, min_y});
+    this->set_max_limit({0, 0});
+    if (this->_scroll_position._y < min_y) {
+        this->set_scroll_position_y(min_y);
+    }
+}
+
+size_t VirtualList::row_at(unsigned long offset) const {
+    if (offset >= this->content_height()) {
+        return this->_row_count;
+    }
+    if (this->_row_height != 0) {
+        return offset / this->_row_height;
+    }
+    /* last row starting at or above offset */
+    auto it = std::upper_bound(this->_row_offsets.begin(), this->_row_offsets.end(), offset);
+    return std::distance(this->_row_offsets.begin(), it) - 1;
+}
+
+void VirtualList::update_rows(bool rebind) {
+    unsigned long top = static_cast<unsigned long>(std::max(0, -this->_scroll_position._y));
+    size_t first = this->row_at(top);
+    size_t last = std::min(this->row_at(top + this->height_ref()) + 1, this->_row_count);
+    first = first > this->_overscan ? first - this->_overscan : 0;
+    last = std::min(last + this->_overscan, this->_row_count);
+
+    TreeTransaction transaction;
+    for (auto it = this->_visible_rows.begin(); it != this->_visible_rows.end();) {
+        if (it->first < first or it->first >= last) {
+            it->second->hide();
+            this->_free_rows.push_back(it->second);
+            it = this->_visible_rows.erase(it);
+        } else {
+            if (rebind) {
+                this->_bind_row(it->second, it->first);
+            }
+            ++it;
+        }
+    }
+    for (size_t row = first; row < last; ++row) {
+        if (this->_visible_rows.find(row) != this->_visible_rows.end()) {
+            continue;
+        }
+        Drawable *drawable;
+        if (this->_free_rows.empty()) {
+            drawable = this->_create_row();
+            this->add_child(drawable);
+        } else {
+            drawable = this->_free_rows.back();
+            this->_free_rows.pop_back();
+            drawable->show();
+        }
+        this->_bind_row(drawable, row);
+        drawable->set_position({drawable->position()._x,
+                                static_cast<int>(this->row_offset(row))});
+        this->_visible_rows[row] = drawable;
+    }
+}
+
+void VirtualList::hook_post_scroll(Position scroll_offset) {
+    Drawable::hook_post_scroll(scroll_offset);
+    this->update_rows();
+}
+
+void VirtualList::hook_post_resize(unsigned width, unsigned height) {
+    Drawable::hook_post_resize(width, height);
+    this->update_scroll_limits();
+    this->update_rows();
+}
+
+size_t VirtualList::row_count() const {
+    return this->_row_count;
+}
+
+void VirtualList::set_row_count(size_t row_count) {
+    this->_row_count = row_count;
+    this->update_row_offsets();
+    this->update_scroll_limits();
+    this->update_rows(true);
+}
+
+unsigned long VirtualList::content_height() const {
+    return this->row_offset(this->_row_count);
+}
+
+unsigned long VirtualList::row_offset(size_t row) const {
+    if (this->_row_height != 0) {
+        return static_cast<unsigned long>(row) * this->_row_height;
+    }
+    return this->_row_offsets[std::min(row, this->_row_count)];
+}
+
+size_t VirtualList::instantiated_rows() const {
+    return this->_visible_rows.size() + this->_free_rows.size();
+}
+
+void VirtualList::refresh() {
+    this->update_rows(true);
+}
+
+void VirtualList::scroll_to(size_t row) {
+    unsigned long offset = std::min(this->row_offset(row), static_cast<unsigned long>(INT_MAX));
+    this->set_scroll_position_y(-static_cast<int>(offset));
+}
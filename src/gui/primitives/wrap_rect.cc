@@ -2,13 +2,23 @@
 
 using namespace SDL_GUI;
 
-void WrapRect::update() {
+void WrapRect::hook_post_child_change(Drawable *child) {
+    (void) child;
+    this->request_layout();
+}
+
+void WrapRect::layout() {
     unsigned width = 0;
     unsigned height = 0;
-    for (const Drawable *d: this->children()) {
+    for (const Drawable *d: this->children_ref()) {
         width = std::max(width, d->position()._x + d->width());
         height = std::max(height, d->position()._y + d->height());
     }
-    this->set_width(width);
-    this->set_height(height);
+    /* resizing invalidates cached layers. Only do it on actual changes. */
+    if (width != this->width_ref()) {
+        this->set_width(width);
+    }
+    if (height != this->height_ref()) {
+        this->set_height(height);
+    }
 }
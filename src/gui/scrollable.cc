@@ -11,6 +11,11 @@ Position Scrollable::scroll_position() const {
     return this->_scroll_position;
 }
 
+bool Scrollable::is_scroll_container() const {
+    return this->_scrolling_x_enabled or this->_scrolling_y_enabled
+           or not (this->_scroll_position == Position(0, 0));
+}
+
 Position Scrollable::min_limit() const {
     return this->_min_limit;
 }
@@ -90,26 +95,32 @@ void Scrollable::scroll_down(int value) {
 void Scrollable::enable_scrolling() {
     this->_scrolling_x_enabled = true;
     this->_scrolling_y_enabled = true;
+    this->hook_post_toggle_scrolling();
 }
 
 void Scrollable::disable_scrolling() {
     this->_scrolling_x_enabled = false;
     this->_scrolling_y_enabled = false;
+    this->hook_post_toggle_scrolling();
 }
 
 void Scrollable::enable_scrolling_x() {
     this->_scrolling_x_enabled = true;
+    this->hook_post_toggle_scrolling();
 }
 
 void Scrollable::disable_scrolling_x() {
     this->_scrolling_x_enabled = false;
+    this->hook_post_toggle_scrolling();
 }
 
 void Scrollable::enable_scrolling_y() {
     this->_scrolling_y_enabled = true;
+    this->hook_post_toggle_scrolling();
 }
 
 void Scrollable::disable_scrolling_y() {
     this->_scrolling_y_enabled = false;
+    this->hook_post_toggle_scrolling();
 }
 
@@ -0,0 +1,128 @@
+#include <gui/texture_atlas.h>
+
+#include <algorithm>
+
+using namespace SDL_GUI;
+
+/** space between packed images so that linear filtering does not bleed into neighbours */
+static const int PADDING = 1;
+
+TextureAtlas::TextureAtlas(int page_size, int max_image_size)
+    : _page_size(page_size), _max_image_size(max_image_size) {}
+
+bool TextureAtlas::fits(const SDL_Surface *surface) const {
+    return surface->w <= this->_max_image_size and surface->h <= this->_max_image_size;
+}
+
+bool TextureAtlas::allocate(Page *page, int width, int height, SDL_Rect *rect) const {
+    int padded_width = width + PADDING;
+    int padded_height = height + PADDING;
+
+    /* use the lowest fitting shelf to not waste space on tall shelves */
+    Shelf *best = nullptr;
+    for (Shelf &shelf: page->_shelves) {
+        if (shelf._height < padded_height or shelf._x + padded_width > this->_page_size) {
+            continue;
+        }
+        if (best == nullptr or shelf._height < best->_height) {
+            best = &shelf;
+        }
+    }
+    if (best == nullptr) {
+        if (page->_y + padded_height > this->_page_size or padded_width > this->_page_size) {
+            return false;
+        }
+        page->_shelves.push_back({page->_y, padded_height, 0});
+        page->_y += padded_height;
+        best = &page->_shelves.back();
+    }
+    *rect = {best->_x, best->_y, width, height};
+    best->_x += padded_width;
+    return true;
+}
+
+TextureRegion TextureAtlas::insert(SDL_Renderer *renderer, SDL_Surface *surface) {
+    TextureRegion region;
+    if (not this->fits(surface)) {
+        return region;
+    }
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (converted == nullptr) {
+        return region;
+    }
+
+    SDL_Rect rect;
+    Page *page = nullptr;
+    for (Page &p: this->_pages) {
+        if (this->allocate(&p, converted->w, converted->h, &rect)) {
+            page = &p;
+            break;
+        }
+    }
+    if (page == nullptr) {
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(renderer, &info) == 0 and info.max_texture_width > 0) {
+            this->_page_size = std::min({this->_page_size, info.max_texture_width,
+                                         info.max_texture_height});
+        }
+        Page new_page;
+        new_page._texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                              SDL_TEXTUREACCESS_STATIC, this->_page_size,
+                                              this->_page_size);
+        if (new_page._texture == nullptr) {
+            SDL_FreeSurface(converted);
+            return region;
+        }
+        SDL_SetTextureBlendMode(new_page._texture, SDL_BLENDMODE_BLEND);
+        /* the padding between images is never written. Linear filtering reads it at the edges of
+         * images, so it has to be transparent instead of uninitialised. */
+        std::vector<Uint32> transparent(static_cast<size_t>(this->_page_size) * this->_page_size);
+        SDL_UpdateTexture(new_page._texture, nullptr, transparent.data(),
+                          this->_page_size * sizeof(Uint32));
+        this->_pages.push_back(new_page);
+        page = &this->_pages.back();
+        if (not this->allocate(page, converted->w, converted->h, &rect)) {
+            SDL_DestroyTexture(page->_texture);
+            this->_pages.pop_back();
+            SDL_FreeSurface(converted);
+            return region;
+        }
+    }
+
+    SDL_UpdateTexture(page->_texture, &rect, converted->pixels, converted->pitch);
+    SDL_FreeSurface(converted);
+    page->_images++;
+    region._texture = page->_texture;
+    region._rect = rect;
+    region._is_atlas_page = true;
+    return region;
+}
+
+void TextureAtlas::remove(const TextureRegion &region) {
+    for (auto it = this->_pages.begin(); it != this->_pages.end(); ++it) {
+        if (it->_texture != region._texture) {
+            continue;
+        }
+        if (--it->_images == 0) {
+            SDL_DestroyTexture(it->_texture);
+            this->_pages.erase(it);
+        }
+        return;
+    }
+}
+
+void TextureAtlas::clear() {
+    for (Page &page: this->_pages) {
+        SDL_DestroyTexture(page._texture);
+    }
+    this->_pages.clear();
+}
+
+size_t TextureAtlas::page_count() const {
+    return this->_pages.size();
+}
+
+size_t TextureAtlas::bytes() const {
+    /* pages are stored with 4 bytes per pixel */
+    return this->_pages.size() * this->_page_size * this->_page_size * 4;
+}
@@ -0,0 +1,489 @@
+#include <gui/texture_cache.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include <SDL2/SDL_image.h>
+
+using namespace SDL_GUI;
+
+/** region returned for images that could not be decoded */
+static const TextureRegion NO_REGION;
+
+std::map<SDL_Renderer *, TextureCache *> TextureCache::_caches;
+std::mutex TextureCache::_caches_mutex;
+
+TextureCache::TextureCache(size_t budget, bool is_surface_cache)
+    : _is_surface_cache(is_surface_cache), _budget(budget) {}
+
+TextureCache::~TextureCache() {
+    delete this->_decoder_pool;
+    for (Decoded &decoded: this->_decoded) {
+        SDL_FreeSurface(decoded._surface);
+    }
+}
+
+TextureCache *TextureCache::of(SDL_Renderer *renderer) {
+    std::lock_guard<std::mutex> lock(TextureCache::_caches_mutex);
+    TextureCache *&cache = TextureCache::_caches[renderer];
+    if (cache == nullptr) {
+        cache = new TextureCache();
+    }
+    return cache;
+}
+
+void TextureCache::destroy(SDL_Renderer *renderer) {
+    TextureCache *cache;
+    {
+        std::lock_guard<std::mutex> lock(TextureCache::_caches_mutex);
+        auto it = TextureCache::_caches.find(renderer);
+        if (it == TextureCache::_caches.end()) {
+            return;
+        }
+        cache = it->second;
+        TextureCache::_caches.erase(it);
+    }
+    cache->clear();
+    delete cache;
+}
+
+void TextureCache::share(SDL_Renderer *renderer, TextureCache *cache) {
+    std::lock_guard<std::mutex> lock(TextureCache::_caches_mutex);
+    TextureCache::_caches[renderer] = cache;
+}
+
+void TextureCache::unshare(SDL_Renderer *renderer) {
+    std::lock_guard<std::mutex> lock(TextureCache::_caches_mutex);
+    TextureCache::_caches.erase(renderer);
+}
+
+unsigned TextureCache::level_for(int width, int height, int target_width, int target_height) {
+    target_width = std::max(target_width, 1);
+    target_height = std::max(target_height, 1);
+    unsigned level = 0;
+    while (level < TextureCache::MAX_LEVEL
+           and (width >> (level + 1)) >= target_width
+           and (height >> (level + 1)) >= target_height) {
+        level++;
+    }
+    return level;
+}
+
+SDL_Surface *TextureCache::downscale(SDL_Surface *surface, unsigned level) {
+    if (level == 0) {
+        return surface;
+    }
+    SDL_Surface *source = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+    for (unsigned i = 0; i < level and source != nullptr; ++i) {
+        int width = std::max(source->w / 2, 1);
+        int height = std::max(source->h / 2, 1);
+        SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                             SDL_PIXELFORMAT_ARGB8888);
+        if (target == nullptr) {
+            break;
+        }
+        for (int y = 0; y < height; ++y) {
+            Uint32 *row = reinterpret_cast<Uint32 *>(static_cast<Uint8 *>(target->pixels)
+                                                     + y * target->pitch);
+            for (int x = 0; x < width; ++x) {
+                /* average the 2x2 source block, colors weighted by their alpha */
+                Uint32 a = 0, r = 0, g = 0, b = 0;
+                for (int dy = 0; dy < 2; ++dy) {
+                    int sy = std::min(2 * y + dy, source->h - 1);
+                    const Uint32 *source_row = reinterpret_cast<const Uint32 *>(
+                        static_cast<const Uint8 *>(source->pixels) + sy * source->pitch);
+                    for (int dx = 0; dx < 2; ++dx) {
+                        Uint32 pixel = source_row[std::min(2 * x + dx, source->w - 1)];
+                        Uint32 alpha = pixel >> 24;
+                        a += alpha;
+                        r += ((pixel >> 16) & 0xff) * alpha;
+                        g += ((pixel >> 8) & 0xff) * alpha;
+                        b += (pixel & 0xff) * alpha;
+                    }
+                }
+                if (a > 0) {
+                    r /= a;
+                    g /= a;
+                    b /= a;
+                }
+                row[x] = ((a / 4) << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+        SDL_FreeSurface(source);
+        source = target;
+    }
+    return source;
+}
+
+void TextureCache::destroy_level(TextureEntry &entry,
+                                 std::map<unsigned, TextureLevel>::iterator it) {
+    TextureLevel &level = it->second;
+    if (level._region._is_atlas_page) {
+        /* only frees memory if this was the last image of its page */
+        size_t atlas_bytes = this->_atlas.bytes();
+        this->_atlas.remove(level._region);
+        this->_bytes -= atlas_bytes - this->_atlas.bytes();
+    } else {
+        if (level._region._surface) {
+            SDL_FreeSurface(level._region._surface);
+        } else if (level._region._texture) {
+            SDL_DestroyTexture(level._region._texture);
+        }
+        /* levels that are still loading have no bytes yet */
+        this->_bytes -= level._bytes;
+    }
+    entry._bytes -= level._bytes;
+    entry._levels.erase(it);
+}
+
+void TextureCache::destroy(std::map<std::string, TextureEntry>::iterator it) {
+    TextureEntry &entry = it->second;
+    while (not entry._levels.empty()) {
+        this->destroy_level(entry, entry._levels.begin());
+    }
+    this->_unused.erase(entry._lru_position);
+    this->_entries.erase(it);
+}
+
+void TextureCache::evict() {
+    while (this->_bytes > this->_budget and not this->_unused.empty()) {
+        this->destroy(this->_entries.find(this->_unused.back()));
+        this->_evictions++;
+    }
+}
+
+void TextureCache::trim_levels() {
+    for (auto &[_, entry]: this->_entries) {
+        size_t uploaded = std::count_if(entry._levels.begin(), entry._levels.end(),
+                                        [](const auto &level){
+                                            return not level.second._is_loading;
+                                        });
+        for (auto it = entry._levels.begin(); it != entry._levels.end() and uploaded > 1;) {
+            const TextureLevel &level = it->second;
+            if (level._is_loading
+                or level._used_frame + TextureCache::UNUSED_LEVEL_FRAMES >= this->_frame) {
+                ++it;
+                continue;
+            }
+            this->destroy_level(entry, it++);
+            uploaded--;
+        }
+    }
+}
+
+SDL_Surface *TextureCache::surface_of(const AssetPackImage *image) {
+    /* the pixels are only read, the surface just references them */
+    return SDL_CreateRGBSurfaceWithFormatFrom(const_cast<void *>(image->_pixels), image->_width,
+                                              image->_height, 32, image->_width * 4,
+                                              SDL_PIXELFORMAT_RGBA32);
+}
+
+void TextureCache::decode(std::string path, unsigned level, int width, int height) {
+    if (this->_decoder_pool == nullptr) {
+        this->_decoder_pool = new ThreadPool();
+    }
+    this->_pending++;
+    const AssetPackImage *image = this->_asset_pack.find(path);
+    this->_decoder_pool->enqueue([this, path, level, width, height, image](){
+            Decoded decoded = {path, level, nullptr, 0, 0};
+            SDL_Surface *surface = image ? TextureCache::surface_of(image)
+                                         : IMG_Load(path.c_str());
+            if (surface != nullptr) {
+                decoded._width = surface->w;
+                decoded._height = surface->h;
+                if (level > TextureCache::MAX_LEVEL) {
+                    decoded._level = TextureCache::level_for(surface->w, surface->h, width,
+                                                             height);
+                }
+                decoded._surface = TextureCache::downscale(surface, decoded._level);
+            }
+            std::lock_guard<std::mutex> lock(this->_decoded_mutex);
+            this->_decoded.push_back(decoded);
+        });
+}
+
+TextureEntry *TextureCache::acquire(std::string path) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(path);
+    if (it != this->_entries.end()) {
+        this->_hits++;
+        TextureEntry &entry = it->second;
+        if (entry._references++ == 0) {
+            this->_unused.erase(entry._lru_position);
+            entry._lru_position = this->_unused.end();
+        }
+        return &entry;
+    }
+
+    this->_misses++;
+    TextureEntry &entry = this->_entries[path];
+    entry._path = path;
+    entry._references = 1;
+    entry._lru_position = this->_unused.end();
+    return &entry;
+}
+
+TextureEntry *TextureCache::lookup(std::string path) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(path);
+    if (it == this->_entries.end()) {
+        this->_misses++;
+        TextureEntry &entry = this->_entries[path];
+        entry._path = path;
+        this->_unused.push_front(path);
+        entry._lru_position = this->_unused.begin();
+        return &entry;
+    }
+    this->_hits++;
+    TextureEntry &entry = it->second;
+    if (entry._references == 0) {
+        this->_unused.splice(this->_unused.begin(), this->_unused, entry._lru_position);
+    }
+    return &entry;
+}
+
+void TextureCache::release(std::string path) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(path);
+    if (it == this->_entries.end()) {
+        return;
+    }
+    TextureEntry &entry = it->second;
+    if (--entry._references == 0) {
+        this->_unused.push_front(path);
+        entry._lru_position = this->_unused.begin();
+    }
+}
+
+bool TextureCache::load_asset_pack(std::string path) {
+    return this->_asset_pack.open(path);
+}
+
+const TextureRegion *TextureCache::find(SDL_Renderer *renderer, TextureEntry *entry, int width,
+                                        int height) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (entry->_is_failed) {
+        return &NO_REGION;
+    }
+    /* packed images know their size without decoding */
+    const AssetPackImage *image = this->_asset_pack.find(entry->_path);
+    if (image != nullptr and entry->_width == 0) {
+        entry->_width = image->_width;
+        entry->_height = image->_height;
+    }
+    /* the size of the image is unknown until it got decoded once */
+    if (entry->_width == 0) {
+        if (not entry->_is_decoding) {
+            entry->_is_decoding = true;
+            this->decode(entry->_path, TextureCache::MAX_LEVEL + 1, width, height);
+        }
+        return nullptr;
+    }
+
+    unsigned level = TextureCache::level_for(entry->_width, entry->_height, width, height);
+    auto it = entry->_levels.find(level);
+    if (it == entry->_levels.end() and image != nullptr and level == 0) {
+        /* full size packed images get uploaded straight from the mapping */
+        SDL_Surface *surface = TextureCache::surface_of(image);
+        if (surface != nullptr) {
+            this->store(*entry, level, surface, renderer);
+            SDL_FreeSurface(surface);
+            if (entry->_is_failed) {
+                return &NO_REGION;
+            }
+            TextureLevel &uploaded = entry->_levels[level];
+            uploaded._used_frame = this->_frame;
+            return &uploaded._region;
+        }
+    }
+    if (it == entry->_levels.end()) {
+        entry->_levels[level] = TextureLevel();
+        this->decode(entry->_path, level, 0, 0);
+    } else if (not it->second._is_loading) {
+        it->second._used_frame = this->_frame;
+        return &it->second._region;
+    }
+
+    /* until the level is uploaded use the closest one, preferably a larger one */
+    TextureLevel *best = nullptr;
+    for (auto &[index, other]: entry->_levels) {
+        if (other._is_loading) {
+            continue;
+        }
+        if (index > level and best != nullptr) {
+            break;
+        }
+        best = &other;
+        if (index > level) {
+            break;
+        }
+    }
+    if (best == nullptr) {
+        return nullptr;
+    }
+    best->_used_frame = this->_frame;
+    return &best->_region;
+}
+
+TextureRegion TextureCache::upload(SDL_Surface *surface, SDL_Renderer *renderer) {
+    TextureRegion region;
+    if (this->_is_surface_cache) {
+        /* the blend kernels only handle ARGB8888 */
+        region._surface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        region._rect = {0, 0, surface->w, surface->h};
+        return region;
+    }
+    if (this->_atlas.fits(surface)) {
+        region = this->_atlas.insert(renderer, surface);
+    }
+    if (region._texture == nullptr) {
+        region._texture = SDL_CreateTextureFromSurface(renderer, surface);
+        region._rect = {0, 0, surface->w, surface->h};
+    }
+    return region;
+}
+
+size_t TextureCache::store(TextureEntry &entry, unsigned index, SDL_Surface *surface,
+                           SDL_Renderer *renderer) {
+    TextureLevel &level = entry._levels[index];
+    size_t atlas_bytes = this->_atlas.bytes();
+    level._region = this->upload(surface, renderer);
+    if (not level._region._is_atlas_page and level._region._surface == nullptr
+        and level._region._texture == nullptr) {
+        /* like an unreadable image, so the level does not get decoded again every frame */
+        std::cerr << "could not upload " << entry._path << ": " << SDL_GetError() << std::endl;
+        entry._levels.erase(index);
+        entry._is_failed = true;
+        return 0;
+    }
+    level._is_loading = false;
+    level._used_frame = this->_frame;
+    /* textures are stored with 4 bytes per pixel */
+    level._bytes = static_cast<size_t>(surface->w) * static_cast<size_t>(surface->h) * 4;
+    entry._bytes += level._bytes;
+    /* atlas pages get charged as a whole when they get created */
+    if (level._region._is_atlas_page) {
+        this->_bytes += this->_atlas.bytes() - atlas_bytes;
+    } else {
+        this->_bytes += level._bytes;
+    }
+    return level._bytes;
+}
+
+bool TextureCache::upload_decoded(SDL_Renderer *renderer, size_t budget) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    size_t uploaded = 0;
+    bool has_uploaded = false;
+    while (uploaded < budget) {
+        Decoded decoded;
+        {
+            std::lock_guard<std::mutex> lock(this->_decoded_mutex);
+            if (this->_decoded.empty()) {
+                break;
+            }
+            decoded = this->_decoded.front();
+            this->_decoded.pop_front();
+        }
+        this->_pending--;
+        auto it = this->_entries.find(decoded._path);
+        /* the image got evicted while decoding */
+        if (it == this->_entries.end()) {
+            SDL_FreeSurface(decoded._surface);
+            continue;
+        }
+        TextureEntry &entry = it->second;
+        entry._is_decoding = false;
+        if (decoded._surface == nullptr) {
+            entry._is_failed = true;
+            continue;
+        }
+        entry._width = decoded._width;
+        entry._height = decoded._height;
+        auto level = entry._levels.find(decoded._level);
+        if (level != entry._levels.end() and not level->second._is_loading) {
+            /* this level got uploaded by an earlier decode */
+            SDL_FreeSurface(decoded._surface);
+            continue;
+        }
+        size_t bytes = this->store(entry, decoded._level, decoded._surface, renderer);
+        uploaded += bytes;
+        has_uploaded = has_uploaded or bytes > 0;
+        SDL_FreeSurface(decoded._surface);
+    }
+
+    if (++this->_frame % TextureCache::UNUSED_LEVEL_FRAMES == 0) {
+        this->trim_levels();
+    }
+    /* also evicts images released since the last frame */
+    this->evict();
+    return has_uploaded;
+}
+
+void TextureCache::clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    /* wait for running decodes */
+    delete this->_decoder_pool;
+    this->_decoder_pool = nullptr;
+    for (Decoded &decoded: this->_decoded) {
+        SDL_FreeSurface(decoded._surface);
+    }
+    this->_decoded.clear();
+    this->_pending = 0;
+
+    for (const auto &[_, entry]: this->_entries) {
+        for (const auto &[_, level]: entry._levels) {
+            if (level._region._surface) {
+                SDL_FreeSurface(level._region._surface);
+            } else if (not level._region._is_atlas_page) {
+                SDL_DestroyTexture(level._region._texture);
+            }
+        }
+    }
+    this->_entries.clear();
+    this->_unused.clear();
+    this->_asset_pack.close();
+    this->_atlas.clear();
+    this->_bytes = 0;
+}
+
+bool TextureCache::is_loading() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_pending > 0;
+}
+
+size_t TextureCache::bytes() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_bytes;
+}
+
+size_t TextureCache::budget() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_budget;
+}
+
+void TextureCache::set_budget(size_t budget) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_budget = budget;
+    this->evict();
+}
+
+size_t TextureCache::size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_entries.size();
+}
+
+unsigned long TextureCache::hits() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_hits;
+}
+
+unsigned long TextureCache::misses() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_misses;
+}
+
+unsigned long TextureCache::evictions() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_evictions;
+}
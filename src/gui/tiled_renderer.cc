@@ -0,0 +1,97 @@
+#include <gui/tiled_renderer.h>
+
+#include <algorithm>
+
+#include <gui/blend.h>
+
+using namespace SDL_GUI;
+
+TiledRenderer::TiledRenderer(SDL_Surface *target, unsigned threads, int tile_size)
+    : _target(target), _tile_size(tile_size), _texture_cache(256 * 1024 * 1024, true),
+      _pool(threads) {
+    for (unsigned i = 0; i < this->_pool.size(); ++i) {
+        Worker worker;
+        worker._surface = SDL_CreateRGBSurfaceWithFormatFrom(target->pixels, target->w,
+                                                             target->h,
+                                                             target->format->BitsPerPixel,
+                                                             target->pitch,
+                                                             target->format->format);
+        worker._renderer = worker._surface ? SDL_CreateSoftwareRenderer(worker._surface)
+                                           : nullptr;
+        if (worker._renderer == nullptr) {
+            SDL_FreeSurface(worker._surface);
+            continue;
+        }
+        SDL_SetRenderDrawBlendMode(worker._renderer, SDL_BLENDMODE_BLEND);
+        blend::register_target(worker._renderer, worker._surface);
+        TextureCache::share(worker._renderer, &this->_texture_cache);
+        this->_workers.push_back(worker);
+    }
+}
+
+TiledRenderer::~TiledRenderer() {
+    this->_pool.wait();
+    for (Worker &worker: this->_workers) {
+        TextureCache::unshare(worker._renderer);
+        blend::unregister_target(worker._renderer);
+        SDL_DestroyRenderer(worker._renderer);
+        SDL_FreeSurface(worker._surface);
+    }
+    this->_texture_cache.clear();
+}
+
+void TiledRenderer::render_tiles(const Worker &worker, const Drawable *root,
+                                 const std::vector<SDL_Rect> &tiles, std::atomic<size_t> *next,
+                                 RGB background) {
+    SDL_Renderer *renderer = worker._renderer;
+    for (size_t i = (*next)++; i < tiles.size(); i = (*next)++) {
+        const SDL_Rect &tile = tiles[i];
+        /* clearing ignores the clip rect, so the background gets filled without blending */
+        SDL_RenderSetClipRect(renderer, &tile);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, background._r, background._g, background._b,
+                               background._a);
+        SDL_RenderFillRect(renderer, &tile);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+        root->render(renderer, {0, 0}, tile, false);
+    }
+    SDL_RenderFlush(renderer);
+}
+
+void TiledRenderer::render(const Drawable *root, SDL_Rect clip_rect, RGB background) {
+    SDL_Rect bounds = {0, 0, this->_target->w, this->_target->h};
+    SDL_Rect area;
+    if (not SDL_IntersectRect(&clip_rect, &bounds, &area)) {
+        return;
+    }
+    std::vector<SDL_Rect> tiles;
+    for (int y = area.y; y < area.y + area.h; y += this->_tile_size) {
+        for (int x = area.x; x < area.x + area.w; x += this->_tile_size) {
+            tiles.push_back({x, y, std::min(this->_tile_size, area.x + area.w - x),
+                             std::min(this->_tile_size, area.y + area.h - y)});
+        }
+    }
+
+    /* the shared cache must not change while the workers draw from it */
+    if (not this->_workers.empty()) {
+        this->_texture_cache.upload_decoded(this->_workers.front()._renderer,
+                                            4 * 1024 * 1024);
+    }
+
+    std::atomic<size_t> next = 0;
+    for (const Worker &worker: this->_workers) {
+        this->_pool.enqueue([&worker, root, &tiles, &next, background](){
+                TiledRenderer::render_tiles(worker, root, tiles, &next, background);
+            });
+    }
+    this->_pool.wait();
+}
+
+unsigned TiledRenderer::threads() const {
+    return this->_workers.size();
+}
+
+bool TiledRenderer::is_loading() const {
+    return this->_texture_cache.is_loading();
+}
@@ -0,0 +1,66 @@
+#include <gui/tree_transaction.h>
+
+#include <gui/drawable.h>
+
+using namespace SDL_GUI;
+
+thread_local TreeTransaction *TreeTransaction::_current = nullptr;
+
+TreeTransaction::TreeTransaction() : _outer(TreeTransaction::_current) {
+    TreeTransaction::_current = this;
+}
+
+TreeTransaction::~TreeTransaction() {
+    this->commit();
+}
+
+TreeTransaction *TreeTransaction::current() {
+    return TreeTransaction::_current;
+}
+
+void TreeTransaction::defer_geometry() {
+    this->_geometry_changed = true;
+}
+
+void TreeTransaction::defer_invalidate(const Drawable *drawable) {
+    this->_invalidated.insert(drawable->handle());
+}
+
+void TreeTransaction::defer_debug_information(const Drawable *drawable) {
+    this->_debug_information.push_back(drawable->handle());
+}
+
+void TreeTransaction::commit() {
+    if (this->_committed) {
+        return;
+    }
+    this->_committed = true;
+    /* the updates below must not get recorded again */
+    TreeTransaction::_current = this->_outer;
+
+    if (this->_outer) {
+        this->_outer->_geometry_changed |= this->_geometry_changed;
+        this->_outer->_invalidated.insert(this->_invalidated.begin(), this->_invalidated.end());
+        this->_outer->_debug_information.insert(this->_outer->_debug_information.end(),
+                                                this->_debug_information.begin(),
+                                                this->_debug_information.end());
+        return;
+    }
+
+    /* debug information is added as children and may change geometry and layers itself */
+    for (Handle handle: this->_debug_information) {
+        Drawable *drawable = Drawable::from_handle(handle);
+        if (drawable) {
+            drawable->init_debug_information();
+        }
+    }
+    if (this->_geometry_changed) {
+        Drawable::_geometry_generation++;
+    }
+    for (Handle handle: this->_invalidated) {
+        Drawable *drawable = Drawable::from_handle(handle);
+        if (drawable) {
+            drawable->invalidate();
+        }
+    }
+}
@@ -1,6 +1,9 @@
 #include <gui/util.h>
 
 #include <math.h>
+#include <stdlib.h>
+
+#include <SDL2_gfx/SDL2_gfxPrimitives.h>
 
 using namespace SDL_GUI::util;
 
@@ -31,3 +34,50 @@ void SDL_GUI::util::HSV_to_RGB(float h, float s, float v, float *r, float *g, fl
         default: *r = v; *g = p; *b = q; break;
     }
 }
+
+void SDL_GUI::util::filled_polygon_RGBA(SDL_Renderer *renderer, const Sint16 *xs, const Sint16 *ys,
+                                        int n, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    /* scanline buffer owned by this call instead of the global one of SDL2_gfx */
+    int *poly_ints = nullptr;
+    int poly_allocated = 0;
+    filledPolygonRGBAMT(renderer, xs, ys, n, r, g, b, a, &poly_ints, &poly_allocated);
+    free(poly_ints);
+}
+
+void SDL_GUI::util::thick_line_RGBA(SDL_Renderer *renderer, Sint16 x1, Sint16 y1, Sint16 x2,
+                                    Sint16 y2, Uint8 width, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    if (width < 1) {
+        return;
+    }
+    if (x1 == x2 and y1 == y2) {
+        Sint16 half = width / 2;
+        boxRGBA(renderer, x1 - half, y1 - half, x2 + width, y2 + width, r, g, b, a);
+        return;
+    }
+    if (width == 1) {
+        lineRGBA(renderer, x1, y1, x2, y2, r, g, b, a);
+        return;
+    }
+    /* same geometry as thickLineRGBA */
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double length = sqrt(dx * dx + dy * dy);
+    double angle = atan2(dx, dy);
+    double adjust = 0.1 + 0.9 * fabs(cos(2.0 * angle));
+    double half_width = (width - adjust) / 2.0;
+    double nx = dx / length;
+    double ny = dy / length;
+    Sint16 xs[4] = {
+        static_cast<Sint16>(x1 + ny * half_width),
+        static_cast<Sint16>(x1 - ny * half_width),
+        static_cast<Sint16>(x2 - ny * half_width),
+        static_cast<Sint16>(x2 + ny * half_width),
+    };
+    Sint16 ys[4] = {
+        static_cast<Sint16>(y1 - nx * half_width),
+        static_cast<Sint16>(y1 + nx * half_width),
+        static_cast<Sint16>(y2 + nx * half_width),
+        static_cast<Sint16>(y2 - nx * half_width),
+    };
+    filled_polygon_RGBA(renderer, xs, ys, 4, r, g, b, a);
+}
@@ -7,13 +7,7 @@
 
 using namespace SDL_GUI;
 
-TTF_Font *InterfaceModel::_font;
-
-
-InterfaceModel::InterfaceModel(SDL_Renderer *renderer, unsigned window_width,
-                               unsigned window_height)
-    : _renderer(renderer), _window_width(window_width), _window_height(window_height) {
-    /* init font */
+TTF_Font *InterfaceModel::open_default_font(int size) {
     FcConfig* config = FcInitLoadConfigAndFonts();
     FcPattern *pat = FcNameParse((const FcChar8 *)"");
     FcConfigSubstitute(config, pat, FcMatchPattern);
@@ -27,8 +21,24 @@ InterfaceModel::InterfaceModel(SDL_Renderer *renderer, unsigned window_width,
             font_file = (char *)file;
         }
     }
-    std::cout << "Font: " << font_file << std::endl;
-    this->_font = TTF_OpenFont(font_file, 12);
+    /* stdout may carry captured frames */
+    std::cerr << "Font: " << font_file << std::endl;
+    TTF_Font *ttf_font = TTF_OpenFont(font_file, size);
+
+    FcPatternDestroy(font);
+    FcPatternDestroy(pat);
+    FcConfigDestroy(config);
+    return ttf_font;
+}
+
+InterfaceModel::InterfaceModel(SDL_Renderer *renderer, unsigned window_width,
+                               unsigned window_height, TTF_Font *font)
+    : _font(font), _owns_font(font == nullptr), _renderer(renderer),
+      _window_width(window_width), _window_height(window_height) {
+    /* init font */
+    if (this->_font == nullptr) {
+        this->_font = InterfaceModel::open_default_font();
+    }
     if (!this->_font) {
         std::cerr << "TTF_Error: " << TTF_GetError() << std::endl;
         exit(EXIT_FAILURE);
@@ -36,18 +46,28 @@ InterfaceModel::InterfaceModel(SDL_Renderer *renderer, unsigned window_width,
     /* init null_drawable */
     this->_null_drawable = new NullDrawable();
 
-    FcPatternDestroy(font);
-    FcPatternDestroy(pat);
-    FcConfigDestroy(config);
+    this->_layer_cache = new LayerCache();
+    this->_render_stats = new RenderStats();
+    this->_mutation_queue = new MutationQueue();
+    this->_reclaimer = new ThreadPool(1);
 }
 
 InterfaceModel::~InterfaceModel() {
     delete this->_null_drawable;
     delete this->_drawable_root;
+    /* removed subtrees still refer to the layer cache */
+    delete this->_reclaimer;
+    /* drawables release their layers on destruction */
+    delete this->_layer_cache;
+    delete this->_render_stats;
+    delete this->_mutation_queue;
+    if (this->_owns_font) {
+        TTF_CloseFont(this->_font);
+    }
 }
 
-TTF_Font *InterfaceModel::font() {
-    return InterfaceModel::_font;
+TTF_Font *InterfaceModel::font() const {
+    return this->_font;
 }
 
 Drawable *InterfaceModel::drawable_root() {
@@ -60,9 +80,10 @@ const Drawable *InterfaceModel::drawable_root() const {
 
 void InterfaceModel::set_drawable_root(Drawable *root) {
     this->_drawable_root = root;
+    root->set_interface_model(this);
 }
 
-SDL_Renderer *InterfaceModel::renderer() {
+SDL_Renderer *InterfaceModel::renderer() const {
     return this->_renderer;
 }
 
@@ -78,6 +99,36 @@ Drawable *InterfaceModel::null_drawable() const {
     return new NullDrawable();
 }
 
+LayerCache *InterfaceModel::layer_cache() const {
+    return this->_layer_cache;
+}
+
+RenderStats *InterfaceModel::render_stats() const {
+    return this->_render_stats;
+}
+
+MutationQueue *InterfaceModel::mutation_queue() const {
+    return this->_mutation_queue;
+}
+
+void InterfaceModel::reclaim(Drawable *subtree) const {
+    if (not this->_background_reclaim) {
+        delete subtree;
+        return;
+    }
+    this->_reclaimer->enqueue([subtree](){
+        delete subtree;
+    });
+}
+
+void InterfaceModel::wait_for_reclaimer() const {
+    this->_reclaimer->wait();
+}
+
+void InterfaceModel::set_background_reclaim(bool background_reclaim) {
+    this->_background_reclaim = background_reclaim;
+}
+
 bool InterfaceModel::debug_information_drawn() const {
     return this->_debug_information_drawn;
 }
@@ -86,6 +137,14 @@ void InterfaceModel::toggle_debug_information_drawn() {
     this->_debug_information_drawn = !this->_debug_information_drawn;
 }
 
+bool InterfaceModel::occlusion_culling() const {
+    return this->_occlusion_culling;
+}
+
+void InterfaceModel::set_occlusion_culling(bool occlusion_culling) {
+    this->_occlusion_culling = occlusion_culling;
+}
+
 std::vector<Drawable *> InterfaceModel::find_drawables(std::string attribute) {
     return this->_drawable_root->filter([attribute](Drawable *d){
         return d->has_attribute(attribute);
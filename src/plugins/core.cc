@@ -1,5 +1,7 @@
 #include <plugins/core.h>
 
+#include <charconv>
+
 using namespace SDL_GUI;
 
 InterfaceModel *Core::interface_model() {
@@ -9,3 +11,14 @@ InterfaceModel *Core::interface_model() {
 InputModel<InputValue, InputState> *Core::input_model() {
     return this->_input_model;
 }
+
+bool Core::parse_count(const std::string &value, unsigned *count) {
+    const char *end = value.data() + value.size();
+    unsigned parsed;
+    auto [parsed_end, error] = std::from_chars(value.data(), end, parsed);
+    if (error != std::errc() or parsed_end != end or parsed == 0) {
+        return false;
+    }
+    *count = parsed;
+    return true;
+}
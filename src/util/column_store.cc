@@ -0,0 +1,42 @@
+#include <util/column_store.h>
+
+using namespace SDL_GUI;
+
+ColumnStore::ColumnStore(std::vector<std::string> names) {
+    for (std::string &name: names) {
+        Column column;
+        column._name = name;
+        column._offsets.push_back(0);
+        this->_columns.push_back(column);
+    }
+}
+
+void ColumnStore::reserve(size_t rows, size_t chars_per_cell) {
+    for (Column &column: this->_columns) {
+        column._chars.reserve(rows * chars_per_cell);
+        column._offsets.reserve(rows + 1);
+    }
+}
+
+void ColumnStore::add_row(const std::vector<std::string> &cells) {
+    for (size_t i = 0; i < this->_columns.size(); ++i) {
+        Column &column = this->_columns[i];
+        if (i < cells.size()) {
+            column._chars += cells[i];
+        }
+        column._offsets.push_back(static_cast<uint32_t>(column._chars.size()));
+    }
+    this->_rows++;
+}
+
+size_t ColumnStore::columns() const {
+    return this->_columns.size();
+}
+
+size_t ColumnStore::rows() const {
+    return this->_rows;
+}
+
+const std::string &ColumnStore::name(size_t column) const {
+    return this->_columns[column]._name;
+}
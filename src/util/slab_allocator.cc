@@ -0,0 +1,61 @@
+#include <util/slab_allocator.h>
+
+#include <algorithm>
+#include <new>
+
+using namespace SDL_GUI;
+
+/** alignment of every block */
+static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+SlabAllocator::SlabAllocator(size_t block_size, size_t slab_size)
+    : _block_size((std::max(block_size, sizeof(FreeBlock)) + ALIGNMENT - 1) / ALIGNMENT
+                  * ALIGNMENT),
+      _slab_size(std::max(slab_size, this->_block_size)) {}
+
+SlabAllocator::~SlabAllocator() {
+    for (char *slab: this->_slabs) {
+        ::operator delete(slab);
+    }
+}
+
+void *SlabAllocator::allocate() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_used++;
+    if (this->_free != nullptr) {
+        FreeBlock *block = this->_free;
+        this->_free = block->_next;
+        return block;
+    }
+    if (this->_next == nullptr or this->_next + this->_block_size > this->_end) {
+        char *slab = static_cast<char *>(::operator new(this->_slab_size));
+        this->_slabs.push_back(slab);
+        this->_next = slab;
+        this->_end = slab + this->_slab_size;
+    }
+    void *block = this->_next;
+    this->_next += this->_block_size;
+    return block;
+}
+
+void SlabAllocator::deallocate(void *block) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_used--;
+    FreeBlock *free_block = static_cast<FreeBlock *>(block);
+    free_block->_next = this->_free;
+    this->_free = free_block;
+}
+
+size_t SlabAllocator::block_size() const {
+    return this->_block_size;
+}
+
+size_t SlabAllocator::used() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_used;
+}
+
+size_t SlabAllocator::reserved() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_slabs.size() * this->_slab_size;
+}
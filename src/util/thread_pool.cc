@@ -0,0 +1,70 @@
+#include <util/thread_pool.h>
+
+#include <algorithm>
+
+using namespace SDL_GUI;
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        this->_workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stopping = true;
+    }
+    this->_condition.notify_all();
+    for (std::thread &worker: this->_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_condition.wait(lock, [this](){
+                    return this->_stopping or not this->_tasks.empty();
+                });
+            if (this->_tasks.empty()) {
+                return;
+            }
+            task = std::move(this->_tasks.front());
+            this->_tasks.pop_front();
+            this->_active++;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_active--;
+            if (this->_active == 0 and this->_tasks.empty()) {
+                this->_idle.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_tasks.push_back(std::move(task));
+    }
+    this->_condition.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_idle.wait(lock, [this](){
+            return this->_active == 0 and this->_tasks.empty();
+        });
+}
+
+unsigned ThreadPool::size() const {
+    return this->_workers.size();
+}
@@ -1,10 +1,14 @@
 #include <views/interface_view.h>
 
+#include <algorithm>
 #include <iostream>
 #include <tuple>
 
+#include <controllers/input_controller.h>
+#include <gui/geometry_store.h>
 #include <gui/primitives/rect.h>
 #include <gui/primitives/text.h>
+#include <gui/primitives/texture.h>
 
 using namespace SDL_GUI;
 
@@ -14,6 +18,91 @@ InterfaceView::InterfaceView(SDL_Renderer *renderer, const InterfaceModel *inter
 }
 
 
+InterfaceView::~InterfaceView() {
+    delete this->_tiled_renderer;
+    if (this->_frame_capture) {
+        this->_frame_capture->finish();
+        std::cerr << "frame capture: " << this->_frame_capture->written() << " frames written, "
+                  << this->_frame_capture->dropped() << " dropped" << std::endl;
+        if (this->_frame_capture->failed()) {
+            std::cerr << "frame capture: writing failed, " << this->_frame_capture->unwritten()
+                      << " captured frames not written" << std::endl;
+        }
+        delete this->_frame_capture;
+    }
+    if (this->_input_latency_count > 0) {
+        std::cerr << "input to present latency: mean "
+                  << this->_input_latency_total / this->_input_latency_count << " ms, max "
+                  << this->_input_latency_max << " ms over " << this->_input_latency_count
+                  << " frames" << std::endl;
+    }
+    if (this->_rendered_frames > 0) {
+        unsigned long frames = this->_rendered_frames;
+        const RenderStats &totals = this->_render_totals;
+        std::cerr << "drawables per frame: mean " << totals._drawn / frames << " drawn, "
+                  << totals._culled / frames << " culled, " << totals._occluded / frames
+                  << " occluded, " << totals._culled_subtrees / frames << " subtrees skipped"
+                  << std::endl;
+        if (this->_window_pixels > 0) {
+            std::cerr << "overdraw: " << static_cast<double>(totals._pixels_drawn)
+                                         / this->_window_pixels
+                      << " drawn pixels per window pixel, "
+                      << static_cast<double>(totals._pixels_occluded) / this->_window_pixels
+                      << " saved by occlusion culling" << std::endl;
+        }
+        std::cerr << "geometry read per frame: mean " << this->_geometry_entries / frames
+                  << " entries of " << sizeof(Geometry) << " bytes" << std::endl;
+    }
+    delete this->_snapshot;
+    delete this->_rendered_snapshot;
+}
+
+void InterfaceView::set_tiled_renderer(TiledRenderer *tiled_renderer) {
+    delete this->_tiled_renderer;
+    this->_tiled_renderer = tiled_renderer;
+}
+
+void InterfaceView::set_frame_capture(FrameCapture *frame_capture) {
+    delete this->_frame_capture;
+    this->_frame_capture = frame_capture;
+}
+
+void InterfaceView::set_snapshot_rendering(bool is_snapshot_rendering) {
+    this->_is_snapshot_rendering = is_snapshot_rendering;
+}
+
+Uint32 InterfaceView::oldest_input_time() {
+    Uint32 oldest = 0;
+    for (const SDL_Event &event: events()) {
+        switch (event.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+            if (oldest == 0 or event.common.timestamp < oldest) {
+                oldest = event.common.timestamp;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return oldest;
+}
+
+void InterfaceView::record_input_latency() {
+    if (this->_input_time == 0) {
+        return;
+    }
+    Uint32 latency = SDL_GetTicks() - this->_input_time;
+    this->_input_latency_count++;
+    this->_input_latency_total += latency;
+    this->_input_latency_max = std::max(this->_input_latency_max, latency);
+    this->_input_time = 0;
+}
+
 bool InterfaceView::init() {
     return true;
 }
@@ -21,14 +110,77 @@ bool InterfaceView::init() {
 void InterfaceView::deinit() {}
 
 void InterfaceView::update() {
+    Uint32 input_time = InterfaceView::oldest_input_time();
+    if (not this->_is_snapshot_rendering) {
+        if (this->_input_time == 0) {
+            this->_input_time = input_time;
+        }
+        return;
+    }
+
+    /* this runs on the update thread, right after the controllers changed the tree */
+    Drawable *snapshot = this->_interface_model->drawable_root()->snapshot();
+    Drawable *unrendered;
+    {
+        std::lock_guard<std::mutex> lock(this->_snapshot_mutex);
+        unrendered = this->_snapshot;
+        this->_snapshot = snapshot;
+        /* inputs of a replaced snapshot get shown by the new one */
+        if (unrendered == nullptr or this->_snapshot_input_time == 0) {
+            this->_snapshot_input_time = input_time;
+        }
+    }
+    /* deleting a whole tree would stall the update thread */
+    if (unrendered != nullptr) {
+        this->_interface_model->reclaim(unrendered);
+    }
 }
 
 void InterfaceView::render() {
-    SDL_SetRenderDrawColor(this->_renderer, 170, 170, 170, 0);
-    SDL_RenderClear(this->_renderer);
+    const Drawable *root = this->_interface_model->drawable_root();
+    if (this->_is_snapshot_rendering) {
+        Drawable *rendered;
+        {
+            std::lock_guard<std::mutex> lock(this->_snapshot_mutex);
+            rendered = this->_rendered_snapshot;
+            if (this->_snapshot) {
+                this->_rendered_snapshot = this->_snapshot;
+                this->_snapshot = nullptr;
+                this->_input_time = this->_snapshot_input_time;
+                this->_snapshot_input_time = 0;
+            }
+        }
+        if (rendered != nullptr and rendered != this->_rendered_snapshot) {
+            this->_interface_model->reclaim(rendered);
+        }
+        /* nothing got published yet */
+        if (this->_rendered_snapshot == nullptr) {
+            return;
+        }
+        root = this->_rendered_snapshot;
+    }
+
+    /* tiles get cleared by the tiled renderer itself. Snapshots have no debug information. */
+    bool is_tiled = this->_tiled_renderer
+                    and (this->_is_snapshot_rendering
+                         or not this->_interface_model->debug_information_drawn());
+    if (not is_tiled) {
+        SDL_SetRenderDrawColor(this->_renderer, 170, 170, 170, 0);
+        SDL_RenderClear(this->_renderer);
+    }
 
 
     SDL_Renderer *renderer = this->_renderer;
+    /* layers of subtrees removed since the last frame */
+    this->_interface_model->layer_cache()->collect();
+    /* cached layers might still show placeholders */
+    if (Texture::upload_decoded(renderer) and not this->_is_snapshot_rendering) {
+        this->_interface_model->layer_cache()->invalidate_all();
+    }
+    RenderStats *render_stats = this->_interface_model->render_stats();
+    render_stats->reset(render_stats->_frame + 1);
+    /* clip rects of changed subtrees are outdated until resolved */
+    root->resolve_subtree_geometry();
     /* draw all drawables recursively */
     SDL_RenderSetClipRect(renderer, NULL);
     SDL_Rect initial_clip_rect = {
@@ -37,8 +189,24 @@ void InterfaceView::render() {
         static_cast<int>(this->_interface_model->window_width()),
         static_cast<int>(this->_interface_model->window_height())
     };
-    this->_interface_model->drawable_root()->render(this->_renderer, {0,0}, initial_clip_rect,
-                                                    false);
+    if (this->_interface_model->occlusion_culling()) {
+        std::vector<SDL_Rect> occluders;
+        root->cull_occluded({0,0}, initial_clip_rect, &occluders, render_stats->_frame);
+    }
+    if (is_tiled) {
+        this->_tiled_renderer->render(root, initial_clip_rect, RGB(170, 170, 170, 0));
+    } else {
+        root->render(this->_renderer, {0,0}, initial_clip_rect, false);
+    }
+    this->_rendered_frames++;
+    this->_geometry_entries += render_stats->geometry_entries();
+    this->_window_pixels += static_cast<unsigned long>(initial_clip_rect.w) * initial_clip_rect.h;
+    this->_render_totals.add(*render_stats);
 
+    /* the content of the back buffer is undefined after presenting */
+    if (this->_frame_capture) {
+        this->_frame_capture->capture(this->_renderer);
+    }
     SDL_RenderPresent(this->_renderer);
+    this->record_input_latency();
 }
@@ -0,0 +1,162 @@
+/**
+ * @file
+ * benchmark of drawing many small icons. The same icons get drawn once from one texture each and
+ * once packed into atlas pages. Drawing from a single page does not switch textures, so SDL can
+ * batch the draws. A hidden window with an accelerated renderer is used if available, the
+ * software renderer otherwise.
+ *
+ * usage: atlas_bench [icons] [frames]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include <gui/texture_atlas.h>
+
+using namespace SDL_GUI;
+
+/** width of rendered frames */
+static const int WIDTH = 1280;
+
+/** height of rendered frames */
+static const int HEIGHT = 720;
+
+/** width and height of icons */
+static const int ICON_SIZE = 32;
+
+/**
+ * time a function
+ * @param f function to time
+ * @return duration in milliseconds
+ */
+static double measure(std::function<void()> f) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point begin = clock::now();
+    f();
+    std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+    return milliseconds.count();
+}
+
+/**
+ * create an icon with a distinct color and a transparent corner
+ * @param index number of icon
+ * @return icon
+ */
+static SDL_Surface *create_icon(int index) {
+    SDL_Surface *icon = SDL_CreateRGBSurfaceWithFormat(0, ICON_SIZE, ICON_SIZE, 32,
+                                                       SDL_PIXELFORMAT_ARGB8888);
+    SDL_FillRect(icon, nullptr, SDL_MapRGBA(icon->format, index * 37, index * 91, index * 13,
+                                            255));
+    SDL_Rect corner = {0, 0, ICON_SIZE / 4, ICON_SIZE / 4};
+    SDL_FillRect(icon, &corner, SDL_MapRGBA(icon->format, 0, 0, 0, 0));
+    return icon;
+}
+
+/**
+ * draw all icons in a grid for a number of frames and print the frame times
+ * @param label description of run
+ * @param renderer renderer to draw with
+ * @param regions icons to draw
+ * @param frames number of frames
+ */
+static void run(const std::string &label, SDL_Renderer *renderer,
+                const std::vector<TextureRegion> &regions, int frames) {
+    int columns = WIDTH / ICON_SIZE;
+    std::vector<double> times;
+    for (int frame = 0; frame < frames; ++frame) {
+        times.push_back(measure([&](){
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+            SDL_RenderClear(renderer);
+            for (size_t i = 0; i < regions.size(); ++i) {
+                /* icons overlap once the window is full, which keeps the number of draws */
+                int cell = i % (columns * (HEIGHT / ICON_SIZE));
+                SDL_Rect destination = {(cell % columns) * ICON_SIZE + frame % 2,
+                                        (cell / columns) * ICON_SIZE, ICON_SIZE, ICON_SIZE};
+                SDL_RenderCopy(renderer, regions[i]._texture, &regions[i]._rect, &destination);
+            }
+            SDL_RenderFlush(renderer);
+        }));
+    }
+    double sum = 0;
+    for (double t: times) {
+        sum += t;
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << std::left << std::setw(10) << label << std::right << std::fixed
+              << std::setprecision(3)
+              << std::setw(10) << sum / times.size() << " ms avg"
+              << std::setw(10) << times[times.size() / 2] << " ms median" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int icon_count = std::max(1, argc > 1 ? std::atoi(argv[1]) : 1000);
+    int frames = std::max(1, argc > 2 ? std::atoi(argv[2]) : 300);
+
+    if (0 != SDL_Init(SDL_INIT_VIDEO)) {
+        std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+    SDL_Window *window = SDL_CreateWindow("atlas_bench", 0, 0, WIDTH, HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = nullptr;
+    SDL_Surface *surface = nullptr;
+    if (window) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    }
+    if (renderer == nullptr) {
+        surface = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+        renderer = SDL_CreateSoftwareRenderer(surface);
+    }
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(renderer, &info);
+    std::cout << icon_count << " icons of " << ICON_SIZE << "x" << ICON_SIZE << ", " << frames
+              << " frames, renderer " << info.name << std::endl;
+
+    std::vector<SDL_Surface *> icons;
+    for (int i = 0; i < icon_count; ++i) {
+        icons.push_back(create_icon(i));
+    }
+
+    std::vector<TextureRegion> separate;
+    for (SDL_Surface *icon: icons) {
+        TextureRegion region;
+        region._texture = SDL_CreateTextureFromSurface(renderer, icon);
+        region._rect = {0, 0, icon->w, icon->h};
+        separate.push_back(region);
+    }
+
+    TextureAtlas atlas;
+    std::vector<TextureRegion> packed;
+    for (SDL_Surface *icon: icons) {
+        packed.push_back(atlas.insert(renderer, icon));
+    }
+    std::cout << atlas.page_count() << " atlas pages" << std::endl;
+
+    run("separate", renderer, separate, frames);
+    run("atlas", renderer, packed, frames);
+
+    atlas.clear();
+    for (TextureRegion &region: separate) {
+        SDL_DestroyTexture(region._texture);
+    }
+    for (SDL_Surface *icon: icons) {
+        SDL_FreeSurface(icon);
+    }
+    SDL_DestroyRenderer(renderer);
+    if (surface) {
+        SDL_FreeSurface(surface);
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <gui/blend.h>
+#include <gui/drawable_tree_builder.h>
+#include <gui/texture_cache.h>
+#include <models/interface_model.h>
+#include <util/string.h>
+#include <util/xml_parser.h>
+#include <views/interface_view.h>
+
+using namespace SDL_GUI;
+
+/** maximum number of frames to wait for textures to finish loading */
+static const unsigned MAX_LOADING_FRAMES = 1000;
+
+/** guards opening fonts, which is not thread safe in SDL_ttf and fontconfig */
+static std::mutex font_mutex;
+
+/** settings shared by all render threads */
+struct BatchJob {
+    std::vector<std::string> _templates;    /**< templates to render */
+    std::string _output_directory;          /**< directory to write the images to */
+    unsigned _width;                        /**< width of images */
+    unsigned _height;                       /**< height of images */
+    std::atomic<size_t> _next{0};           /**< index of next template to render */
+    std::atomic<size_t> _failed{0};         /**< number of templates that could not be rendered */
+};
+
+/**
+ * render a single template to a png file
+ * @param job settings of batch
+ * @param renderer software renderer of this thread
+ * @param surface surface the renderer renders to
+ * @param font font of this thread
+ * @param template_path path to template
+ * @param output_path path of png file
+ * @return whether the image got written
+ */
+static bool render_template(const BatchJob *job, SDL_Renderer *renderer, SDL_Surface *surface,
+                            TTF_Font *font, std::string template_path, std::string output_path) {
+    InterfaceModel *interface_model = new InterfaceModel(renderer, job->_width, job->_height,
+                                                         font);
+    DrawableTreeBuilder builder(interface_model->font());
+    XmlParser<DrawableTreeBuilder, Drawable> parser(&builder);
+    interface_model->set_drawable_root(parser.parse_file(template_path));
+    InterfaceView *interface_view = new InterfaceView(renderer, interface_model);
+
+    /* render until all textures got decoded and uploaded */
+    TextureCache *texture_cache = TextureCache::of(renderer);
+    unsigned frames = 0;
+    do {
+        if (frames > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        interface_model->drawable_root()->map([](Drawable *drawable) {
+                drawable->recalculate();
+            });
+        interface_model->drawable_root()->map([](Drawable *drawable) {
+                drawable->update();
+            });
+        interface_model->drawable_root()->update_layout();
+        interface_view->render();
+    } while (texture_cache->is_loading() and ++frames < MAX_LOADING_FRAMES);
+
+    bool success = IMG_SavePNG(surface, output_path.c_str()) == 0;
+    delete interface_view;
+    delete interface_model;
+    return success;
+}
+
+/**
+ * render templates of a batch until none is left
+ * @param job settings of batch
+ */
+static void render_thread(BatchJob *job) {
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, job->_width, job->_height, 32,
+                                                          SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    TTF_Font *font;
+    {
+        std::lock_guard<std::mutex> lock(font_mutex);
+        font = InterfaceModel::open_default_font();
+    }
+    if (renderer == nullptr or font == nullptr) {
+        std::cerr << "unable to create renderer: " << SDL_GetError() << std::endl;
+        job->_failed += job->_templates.size();
+        job->_next = job->_templates.size();
+    } else {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        blend::register_target(renderer, surface);
+        for (size_t i = job->_next++; i < job->_templates.size(); i = job->_next++) {
+            std::string name = split_string(job->_templates[i], "/").back();
+            std::string output_path = job->_output_directory + "/" + name + ".png";
+            if (not render_template(job, renderer, surface, font, job->_templates[i],
+                                    output_path)) {
+                std::cerr << "unable to write " << output_path << std::endl;
+                job->_failed++;
+            }
+        }
+        TextureCache::destroy(renderer);
+        blend::unregister_target(renderer);
+    }
+
+    if (font) {
+        std::lock_guard<std::mutex> lock(font_mutex);
+        TTF_CloseFont(font);
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+
+/**
+ * Render templates to png files offline with independent software renderers on multiple threads.
+ * For each given number of threads all templates get rendered once and the throughput gets
+ * reported.
+ */
+int main(int argc, char *argv[]) {
+    std::vector<unsigned> thread_counts;
+    unsigned width = 1920;
+    unsigned height = 1080;
+    int i = 1;
+    for (; i < argc and argv[i][0] == '-'; i += 2) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            break;
+        }
+        if (option == "-j") {
+            for (std::string count: split_string(argv[i + 1], ",")) {
+                thread_counts.push_back(std::stoul(count));
+            }
+        } else if (option == "-w") {
+            width = std::stoul(argv[i + 1]);
+        } else if (option == "-h") {
+            height = std::stoul(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (argc - i < 2) {
+        std::cerr << "usage: " << argv[0]
+                  << " [-j threads[,threads...]] [-w width] [-h height] <output directory>"
+                  << " <template>..." << std::endl;
+        return 1;
+    }
+    if (thread_counts.empty()) {
+        thread_counts.push_back(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    for (unsigned thread_count: thread_counts) {
+        BatchJob job;
+        job._output_directory = argv[i];
+        job._templates.assign(argv + i + 1, argv + argc);
+        job._width = width;
+        job._height = height;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < std::max(1u, thread_count); ++t) {
+            threads.emplace_back(render_thread, &job);
+        }
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+        size_t rendered = job._templates.size() - job._failed;
+        std::cout << "threads: " << thread_count << "  images: " << rendered
+                  << "  seconds: " << seconds.count()
+                  << "  images/s: " << rendered / seconds.count() << std::endl;
+        success = success and job._failed == 0;
+    }
+
+    TTF_Quit();
+    return success ? 0 : 1;
+}
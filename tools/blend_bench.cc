@@ -0,0 +1,123 @@
+/**
+ * @file
+ * microbenchmark of the blend kernels. Every implementation the CPU supports gets timed on the
+ * same rows of pixels and its results get compared with the scalar implementation.
+ *
+ * usage: blend_bench [width] [rows]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gui/blend.h>
+
+using namespace SDL_GUI;
+
+/** number of times every kernel runs over all rows */
+static const int ITERATIONS = 20;
+
+/**
+ * time a kernel and print its throughput
+ * @param label name of kernel
+ * @param pixels number of pixels one run processes
+ * @param run function that runs the kernel once
+ * @return pixels per second
+ */
+static double measure(const std::string &label, size_t pixels, std::function<void()> run) {
+    using clock = std::chrono::steady_clock;
+    run();
+    clock::time_point begin = clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        run();
+    }
+    std::chrono::duration<double> seconds = clock::now() - begin;
+    double rate = pixels * ITERATIONS / seconds.count();
+    std::cout << "  " << std::left << std::setw(8) << label << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << rate / 1e6 << " Mpx/s" << std::endl;
+    return rate;
+}
+
+int main(int argc, char *argv[]) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 1920;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 1080;
+    size_t pixels = static_cast<size_t>(width) * rows;
+
+    /* odd values make sure the remainders after the vectorised parts get exercised */
+    std::mt19937 random(42);
+    std::vector<Uint32> background(pixels);
+    std::vector<Uint32> source(pixels);
+    std::vector<Uint8> coverage(pixels);
+    for (size_t i = 0; i < pixels; ++i) {
+        background[i] = random();
+        source[i] = random();
+        coverage[i] = random();
+    }
+    const Uint32 color = 0x80c04020;
+
+    std::vector<Uint32> expected_fill = background;
+    std::vector<Uint32> expected_blit = background;
+    std::vector<Uint32> expected_a8 = background;
+    blend::use(blend::Implementation::SCALAR);
+    for (int y = 0; y < rows; ++y) {
+        blend::fill(expected_fill.data() + y * width, width, color);
+        blend::blit(expected_blit.data() + y * width, source.data() + y * width, width);
+        blend::blit_a8(expected_a8.data() + y * width, coverage.data() + y * width, width, color);
+    }
+
+    std::cout << width << "x" << rows << " pixels, " << ITERATIONS << " iterations" << std::endl;
+    bool correct = true;
+    for (blend::Implementation implementation: {blend::Implementation::SCALAR,
+                                                blend::Implementation::SSE2,
+                                                blend::Implementation::AVX2,
+                                                blend::Implementation::NEON}) {
+        if (not blend::use(implementation)) {
+            continue;
+        }
+        std::cout << blend::name(implementation) << std::endl;
+        std::vector<Uint32> dst;
+
+        auto fill = [&](){
+            for (int y = 0; y < rows; ++y) {
+                blend::fill(dst.data() + y * width, width, color);
+            }
+        };
+        auto blit = [&](){
+            for (int y = 0; y < rows; ++y) {
+                blend::blit(dst.data() + y * width, source.data() + y * width, width);
+            }
+        };
+        auto blit_a8 = [&](){
+            for (int y = 0; y < rows; ++y) {
+                blend::blit_a8(dst.data() + y * width, coverage.data() + y * width, width, color);
+            }
+        };
+
+        /* a single run on the original background is compared, the timed runs blend further */
+        dst = background;
+        fill();
+        correct &= dst == expected_fill;
+        measure("fill", pixels, fill);
+
+        dst = background;
+        blit();
+        correct &= dst == expected_blit;
+        measure("blit", pixels, blit);
+
+        dst = background;
+        blit_a8();
+        correct &= dst == expected_a8;
+        measure("blit_a8", pixels, blit_a8);
+    }
+
+    if (not correct) {
+        std::cerr << "results differ from the scalar implementation" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
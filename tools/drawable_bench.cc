@@ -0,0 +1,154 @@
+/**
+ * @file
+ * benchmark of drawable allocation. A tree of drawables gets built, traversed and torn down once
+ * with the slab allocators and once with the default allocator. Each run happens in its own
+ * process since the allocator is chosen on the first allocation of a drawable. Cache misses during
+ * traversal are counted with the performance counters of the kernel if they are accessible.
+ *
+ * usage: drawable_bench [drawables] [children per drawable]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gui/primitives/rect.h>
+
+using namespace SDL_GUI;
+
+/** number of traversals of the tree */
+static const int TRAVERSALS = 10;
+
+/** result of traversals, keeps them from being optimised away */
+static volatile long sink;
+
+/**
+ * open a counter of cache misses of this process
+ * @return file descriptor of counter. -1 if counters are not accessible.
+ */
+static int open_cache_miss_counter() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * add children to a drawable until the tree has a given size
+ * @param root drawable to add children to
+ * @param drawables number of drawables to create
+ * @param fanout number of children per drawable
+ */
+static void build(Drawable *root, int drawables, int fanout) {
+    std::vector<Drawable *> parents = {root};
+    int created = 0;
+    for (size_t p = 0; created < drawables; ++p) {
+        for (int i = 0; i < fanout and created < drawables; ++i, ++created) {
+            Rect *rect = new Rect({i, 1}, 10, 10);
+            /* attributes are allocated in between like in parsed templates */
+            rect->add_attribute("rect" + std::to_string(created));
+            parents[p]->add_child(rect);
+            parents.push_back(rect);
+        }
+    }
+}
+
+/**
+ * run the benchmark with the allocator of this process and print the results
+ * @param label name of allocator
+ * @param drawables number of drawables
+ * @param fanout number of children per drawable
+ */
+static void run(const std::string &label, int drawables, int fanout) {
+    using clock = std::chrono::steady_clock;
+    std::chrono::duration<double, std::milli> build_time;
+    std::chrono::duration<double, std::milli> traversal_time;
+    std::chrono::duration<double, std::milli> teardown_time;
+
+    clock::time_point begin = clock::now();
+    Rect *root = new Rect();
+    build(root, drawables, fanout);
+    build_time = clock::now() - begin;
+
+    int counter = open_cache_miss_counter();
+    long long misses = 0;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    long sum = 0;
+    begin = clock::now();
+    for (int i = 0; i < TRAVERSALS; ++i) {
+        root->map([&sum](Drawable *d){
+            sum += d->absolute_position()._x + d->width();
+        });
+    }
+    traversal_time = clock::now() - begin;
+    sink = sum;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+            misses = -1;
+        }
+        close(counter);
+    }
+
+    begin = clock::now();
+    delete root;
+    teardown_time = clock::now() - begin;
+
+    std::cout << std::left << std::setw(8) << label << std::right << std::fixed
+              << std::setprecision(2)
+              << std::setw(10) << build_time.count() << " ms build"
+              << std::setw(10) << teardown_time.count() << " ms teardown"
+              << std::setw(10) << traversal_time.count() / TRAVERSALS << " ms traversal";
+    if (counter >= 0 and misses >= 0) {
+        std::cout << std::setw(12) << misses / TRAVERSALS << " cache misses";
+    } else {
+        std::cout << "    cache misses not accessible";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int drawables = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int fanout = argc > 2 ? std::atoi(argv[2]) : 8;
+    std::cout << drawables << " drawables, " << fanout << " children per drawable" << std::endl;
+
+    for (bool is_slab: {true, false}) {
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "fork failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (pid == 0) {
+            if (not is_slab) {
+                setenv("SDL_GUI_NO_SLAB", "1", 1);
+            }
+            run(is_slab ? "slab" : "malloc", drawables, fanout);
+            return EXIT_SUCCESS;
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        if (not WIFEXITED(status) or WEXITSTATUS(status) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
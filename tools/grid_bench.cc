@@ -0,0 +1,172 @@
+/**
+ * @file
+ * benchmark of scrolling a data grid with a large number of rows. The grid gets scrolled a few
+ * rows per frame, then jumps to random rows every frame, both before and after sorting it by a
+ * column. Frames get rendered with the software renderer.
+ *
+ * usage: grid_bench [rows] [columns] [frames]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <gui/blend.h>
+#include <gui/primitives/data_grid.h>
+#include <models/interface_model.h>
+
+using namespace SDL_GUI;
+
+/** width of rendered frames */
+static const int WIDTH = 1280;
+
+/** height of rendered frames */
+static const int HEIGHT = 720;
+
+/**
+ * time a function
+ * @param f function to time
+ * @return duration in milliseconds
+ */
+static double measure(std::function<void()> f) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point begin = clock::now();
+    f();
+    std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+    return milliseconds.count();
+}
+
+/**
+ * create a table of numbers and short words
+ * @param rows number of rows
+ * @param columns number of columns
+ * @return table
+ */
+static ColumnStore *create_data(size_t rows, size_t columns) {
+    static const std::vector<std::string> words = {"alpha", "beta", "gamma", "delta", "epsilon",
+                                                   "zeta", "eta", "theta", "iota", "kappa"};
+    std::vector<std::string> names;
+    for (size_t column = 0; column < columns; ++column) {
+        names.push_back("column " + std::to_string(column));
+    }
+    ColumnStore *data = new ColumnStore(names);
+    data->reserve(rows);
+    std::mt19937 random(42);
+    std::vector<std::string> cells(columns);
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t column = 0; column < columns; ++column) {
+            if (column % 3 == 2) {
+                cells[column] = words[random() % words.size()];
+            } else {
+                cells[column] = std::to_string(random() % 100000);
+            }
+        }
+        data->add_row(cells);
+    }
+    return data;
+}
+
+/**
+ * render frames of a grid and print the frame times
+ * @param label description of run
+ * @param renderer software renderer
+ * @param grid grid to render
+ * @param frames number of frames
+ * @param scroll function that scrolls the grid before a frame
+ */
+static void run(const std::string &label, SDL_Renderer *renderer, DataGrid *grid, int frames,
+                std::function<void(int)> scroll) {
+    std::vector<double> times;
+    for (int frame = 0; frame < frames; ++frame) {
+        times.push_back(measure([&](){
+            scroll(frame);
+            grid->update();
+            grid->resolve_subtree_geometry();
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+            SDL_RenderClear(renderer);
+            grid->render(renderer, {0, 0}, {0, 0, WIDTH, HEIGHT}, false);
+            SDL_RenderFlush(renderer);
+        }));
+    }
+    double sum = 0;
+    for (double t: times) {
+        sum += t;
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << std::left << std::setw(10) << label << std::right << std::fixed
+              << std::setprecision(2)
+              << std::setw(8) << sum / times.size() << " ms avg"
+              << std::setw(8) << times[times.size() * 99 / 100] << " ms p99"
+              << std::setw(8) << times.back() << " ms max" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t rows = argc > 1 ? std::atol(argv[1]) : 1000000;
+    size_t columns = argc > 2 ? std::atol(argv[2]) : 30;
+    int frames = std::max(1, argc > 3 ? std::atoi(argv[3]) : 300);
+
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    TTF_Font *font = InterfaceModel::open_default_font();
+    if (font == nullptr) {
+        std::cerr << "unable to open font: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32,
+                                                          SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    blend::register_target(renderer, surface);
+
+    ColumnStore *data = nullptr;
+    double build_time = measure([&](){
+        data = create_data(rows, columns);
+    });
+    std::cout << rows << " rows, " << columns << " columns, built in " << std::fixed
+              << std::setprecision(2) << build_time << " ms" << std::endl;
+
+    DataGrid *grid = new DataGrid(font, std::shared_ptr<const ColumnStore>(data), {0, 0}, WIDTH,
+                                  HEIGHT, 80);
+    std::mt19937 random(7);
+    int max_offset = -grid->min_limit()._y;
+    auto step = [grid](int){
+        grid->scroll_up(60);
+    };
+    auto jump = [grid, &random, max_offset](int){
+        grid->set_scroll_position_y(-static_cast<int>(random() % (max_offset + 1)));
+    };
+    run("scroll", renderer, grid, frames, step);
+    run("jump", renderer, grid, frames, jump);
+
+    double sort_time = measure([&](){
+        grid->sort(0);
+        grid->wait();
+        grid->update();
+    });
+    std::cout << "sort by column 0 in " << sort_time << " ms" << std::endl;
+    grid->set_scroll_position_y(0);
+    run("scroll", renderer, grid, frames, step);
+    run("jump", renderer, grid, frames, jump);
+
+    const GlyphRunCache *glyph_runs = grid->glyph_runs();
+    std::cout << glyph_runs->size() << " glyph runs, " << glyph_runs->hits() << " hits, "
+              << glyph_runs->misses() << " misses" << std::endl;
+
+    delete grid;
+    blend::unregister_target(renderer);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    TTF_CloseFont(font);
+    TTF_Quit();
+    return EXIT_SUCCESS;
+}
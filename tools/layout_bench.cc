@@ -0,0 +1,193 @@
+/**
+ * @file
+ * benchmark of building trees and resolving their geometry. Deep and wide trees get built bottom
+ * up like the template parser does, their geometry gets resolved in a single pass and finally the
+ * whole tree gets moved and resolved again. Scrolling the root and resolving again gets measured
+ * as well, scrolling does not change the stored geometry of the childs. The wide tree also gets
+ * built inside a single transaction.
+ * Finally a layout of nested stacks of text labels gets built and the text of a single label
+ * changed, comparing the incremental relayout to laying out every stack again.
+ *
+ * usage: layout_bench [drawables]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL_ttf.h>
+
+#include <gui/primitives/rect.h>
+#include <gui/primitives/stack.h>
+#include <gui/primitives/text.h>
+#include <gui/tree_transaction.h>
+#include <models/interface_model.h>
+
+using namespace SDL_GUI;
+
+/**
+ * build a chain of drawables bottom up, each drawable the only child of the next one
+ * @param drawables number of drawables
+ * @return root of chain
+ */
+static Drawable *build_deep(int drawables) {
+    Drawable *current = new Rect({1, 1}, 10, 10);
+    for (int i = 1; i < drawables; ++i) {
+        Drawable *parent = new Rect({1, 1}, 10 + i, 10 + i);
+        parent->add_child(current);
+        current = parent;
+    }
+    return current;
+}
+
+/**
+ * build a tree of rows with many drawables each, children get added before their parent
+ * @param drawables number of drawables
+ * @return root of tree
+ */
+static Drawable *build_wide(int drawables) {
+    Drawable *root = new Rect({0, 0}, 1920, 1080);
+    for (int created = 1; created < drawables;) {
+        Drawable *row = new Rect({0, created / 1000}, 1920, 1);
+        created++;
+        for (int i = 0; i < 999 and created < drawables; ++i, ++created) {
+            row->add_child(new Rect({i * 2, 0}, 2, 1));
+        }
+        root->add_child(row);
+    }
+    return root;
+}
+
+/**
+ * time a function
+ * @param f function to time
+ * @return duration in milliseconds
+ */
+static double measure(std::function<void()> f) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point begin = clock::now();
+    f();
+    std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+    return milliseconds.count();
+}
+
+/**
+ * build, resolve, move, resolve and scroll a tree and print the times
+ * @param label shape of tree
+ * @param build function that builds the tree
+ */
+static void run(const std::string &label, std::function<Drawable *()> build) {
+    Drawable *root = nullptr;
+    double build_time = measure([&](){
+        root = build();
+    });
+    double resolve_time = measure([&](){
+        root->resolve_subtree_geometry();
+    });
+    double unchanged_time = measure([&](){
+        root->resolve_subtree_geometry();
+    });
+    double move_time = measure([&](){
+        root->move({1, 1});
+        root->resolve_subtree_geometry();
+    });
+    /* childs of scroll containers store their geometry without its clip rect */
+    root->enable_scrolling();
+    root->resolve_subtree_geometry();
+    double scroll_time = measure([&](){
+        root->scroll_down(1);
+        root->resolve_subtree_geometry();
+    });
+    std::cout << std::left << std::setw(6) << label << std::right << std::fixed
+              << std::setprecision(2)
+              << std::setw(10) << build_time << " ms build"
+              << std::setw(10) << resolve_time << " ms resolve"
+              << std::setw(10) << unchanged_time << " ms unchanged"
+              << std::setw(10) << move_time << " ms move"
+              << std::setw(10) << scroll_time << " ms scroll" << std::endl;
+    delete root;
+}
+
+/**
+ * build a vertical stack of horizontal stacks of labels, change the text of a single label and
+ * print the times of the relayouts
+ * @param font font of labels
+ * @param drawables number of drawables
+ */
+static void run_layout(TTF_Font *font, int drawables) {
+    const int labels_per_row = 99;
+    Stack *root = new Stack(Stack::Direction::VERTICAL);
+    root->set_spacing(2);
+    std::vector<Stack *> stacks = {root};
+    std::vector<Text *> labels;
+    for (int created = 1; created < drawables;) {
+        Stack *row = new Stack(Stack::Direction::HORIZONTAL);
+        row->set_spacing(4);
+        row->set_alignment(Stack::Alignment::CENTER);
+        stacks.push_back(row);
+        created++;
+        for (int i = 0; i < labels_per_row and created < drawables; ++i, ++created) {
+            Text *label = new Text(font, "label " + std::to_string(created));
+            labels.push_back(label);
+            row->add_child(label);
+        }
+        root->add_child(row);
+    }
+
+    double initial_time = measure([&](){
+        root->update_layout();
+    });
+    Text *label = labels[labels.size() / 2];
+    double label_time = measure([&](){
+        label->set_text("changed label");
+        root->update_layout();
+    });
+    double full_time = measure([&](){
+        label->set_text("label");
+        for (Stack *stack: stacks) {
+            stack->set_spacing(stack->spacing());
+        }
+        root->update_layout();
+    });
+    std::cout << std::left << std::setw(6) << "stack" << std::right << std::fixed
+              << std::setprecision(3)
+              << std::setw(10) << initial_time << " ms layout"
+              << std::setw(10) << label_time << " ms label"
+              << std::setw(10) << full_time << " ms full relayout" << std::endl;
+    delete root;
+}
+
+int main(int argc, char *argv[]) {
+    int drawables = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::cout << drawables << " drawables" << std::endl;
+    /* the chain is limited in depth, since drawables get resolved and deleted recursively */
+    run("deep", [drawables](){
+        return build_deep(std::min(drawables, 10000));
+    });
+    run("wide", [drawables](){
+        return build_wide(drawables);
+    });
+    run("batch", [drawables](){
+        TreeTransaction transaction;
+        return build_wide(drawables);
+    });
+
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    TTF_Font *font = InterfaceModel::open_default_font();
+    if (font == nullptr) {
+        std::cerr << "TTF_Error: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    run_layout(font, std::min(drawables, 10000));
+    TTF_CloseFont(font);
+    TTF_Quit();
+    return EXIT_SUCCESS;
+}
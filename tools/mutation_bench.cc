@@ -0,0 +1,97 @@
+/**
+ * @file
+ * throughput benchmark of the mutation queue. Producer threads queue changes of position to the
+ * drawables of a tree while a consumer applies them in batches like the interface controller does.
+ *
+ * usage: mutation_bench [mutations per producer] [drawables]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gui/mutation_queue.h>
+#include <gui/primitives/rect.h>
+
+using namespace SDL_GUI;
+
+/**
+ * run one round of the benchmark and print its throughput
+ * @param targets handles of drawables that get moved
+ * @param producers number of producer threads
+ * @param mutations number of mutations every producer queues
+ * @return whether every mutation got applied
+ */
+static bool measure(const std::vector<Handle> &targets, int producers, int mutations) {
+    using clock = std::chrono::steady_clock;
+    MutationQueue queue;
+    std::atomic<bool> is_producing = true;
+    unsigned long applied = 0;
+    unsigned long batches = 0;
+
+    clock::time_point begin = clock::now();
+    std::thread consumer([&](){
+        while (is_producing or not queue.empty()) {
+            unsigned count = queue.apply();
+            if (count > 0) {
+                applied += count;
+                batches++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, &targets, p, mutations](){
+            for (int i = 0; i < mutations; ++i) {
+                queue.set_position(targets[(p + i) % targets.size()], {i, p});
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    is_producing = false;
+    consumer.join();
+    std::chrono::duration<double> seconds = clock::now() - begin;
+
+    unsigned long total = static_cast<unsigned long>(producers) * mutations;
+    std::cout << std::setw(3) << producers << " producers " << std::fixed << std::setprecision(2)
+              << std::setw(8) << total / seconds.count() / 1e6 << " M mutations/s, "
+              << std::setw(7) << (batches > 0 ? applied / batches : 0) << " per batch"
+              << std::endl;
+    return applied == total;
+}
+
+int main(int argc, char *argv[]) {
+    int mutations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int drawables = argc > 2 ? std::atoi(argv[2]) : 64;
+
+    Rect *root = new Rect();
+    std::vector<Handle> targets;
+    for (int i = 0; i < drawables; ++i) {
+        Rect *rect = new Rect({i, i}, 10, 10);
+        root->add_child(rect);
+        targets.push_back(rect->handle());
+    }
+
+    std::cout << drawables << " drawables, " << mutations << " mutations per producer"
+              << std::endl;
+    bool correct = true;
+    for (int producers: {1, 2, 4, 8, 16}) {
+        correct &= measure(targets, producers, mutations);
+    }
+    delete root;
+
+    if (not correct) {
+        std::cerr << "not every mutation got applied" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
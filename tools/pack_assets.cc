@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <gui/asset_pack.h>
+
+using namespace SDL_GUI;
+
+/**
+ * Offline packer for asset packs.
+ * The images are stored under the path they are given with, so they have to be given the same way
+ * the templates reference them (e.g. textures/strichmann.png).
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <pack> <image>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, SDL_Surface *>> images;
+    bool success = true;
+    for (int i = 2; i < argc; ++i) {
+        SDL_Surface *surface = IMG_Load(argv[i]);
+        if (surface == nullptr) {
+            std::cerr << "could not load " << argv[i] << ": " << IMG_GetError() << std::endl;
+            success = false;
+            break;
+        }
+        images.emplace_back(argv[i], surface);
+    }
+
+    if (success) {
+        success = AssetPack::write(argv[1], images);
+        if (not success) {
+            std::cerr << "could not write " << argv[1] << std::endl;
+        }
+    }
+    for (auto &[_, surface]: images) {
+        SDL_FreeSurface(surface);
+    }
+    if (not success) {
+        return 1;
+    }
+    std::cout << "packed " << images.size() << " images into " << argv[1] << std::endl;
+    return 0;
+}
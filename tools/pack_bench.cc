@@ -0,0 +1,160 @@
+/**
+ * @file
+ * startup benchmark of asset packs. The given images get loaded into textures once by decoding
+ * their files with IMG_LoadTexture and once from a memory-mapped asset pack of them. Every run
+ * loads all images and destroys the textures again. The files get read once before timing, so
+ * both variants run from the page cache.
+ *
+ * usage: pack_bench <image>...
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <gui/asset_pack.h>
+
+using namespace SDL_GUI;
+
+/** number of times all images get loaded */
+static const int RUNS = 10;
+
+/** path of the temporary asset pack */
+static const char *PACK_PATH = "pack_bench.sgpk";
+
+/**
+ * time a function
+ * @param f function to time
+ * @return duration in milliseconds
+ */
+static double measure(std::function<void()> f) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point begin = clock::now();
+    f();
+    std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+    return milliseconds.count();
+}
+
+/**
+ * load all images for a number of runs and print the load times
+ * @param label description of run
+ * @param renderer renderer to create the textures with
+ * @param load function that loads all images into textures
+ */
+static void run(const std::string &label, SDL_Renderer *renderer,
+                std::function<void(std::vector<SDL_Texture *> *)> load) {
+    std::vector<double> times;
+    for (int i = 0; i < RUNS; ++i) {
+        std::vector<SDL_Texture *> textures;
+        times.push_back(measure([&](){
+            load(&textures);
+            /* make sure the uploads are done */
+            SDL_RenderFlush(renderer);
+        }));
+        for (SDL_Texture *texture: textures) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+    double sum = 0;
+    for (double t: times) {
+        sum += t;
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << std::left << std::setw(16) << label << std::right << std::fixed
+              << std::setprecision(2)
+              << std::setw(10) << sum / times.size() << " ms avg"
+              << std::setw(10) << times.front() << " ms min" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <image>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> paths(argv + 1, argv + argc);
+
+    if (0 != SDL_Init(SDL_INIT_VIDEO)) {
+        std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    SDL_Window *window = SDL_CreateWindow("pack_bench", 0, 0, 64, 64, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = nullptr;
+    SDL_Surface *target = nullptr;
+    if (window) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    }
+    if (renderer == nullptr) {
+        target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+        renderer = SDL_CreateSoftwareRenderer(target);
+    }
+
+    /* this also reads all files into the page cache */
+    std::vector<std::pair<std::string, SDL_Surface *>> images;
+    size_t pixels = 0;
+    for (const std::string &path: paths) {
+        SDL_Surface *surface = IMG_Load(path.c_str());
+        if (surface == nullptr) {
+            std::cerr << "could not load " << path << ": " << IMG_GetError() << std::endl;
+            return EXIT_FAILURE;
+        }
+        pixels += static_cast<size_t>(surface->w) * surface->h;
+        images.emplace_back(path, surface);
+    }
+    bool is_written = AssetPack::write(PACK_PATH, images);
+    for (auto &[_, surface]: images) {
+        SDL_FreeSurface(surface);
+    }
+    if (not is_written) {
+        std::cerr << "could not write " << PACK_PATH << std::endl;
+        return EXIT_FAILURE;
+    }
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(renderer, &info);
+    std::cout << paths.size() << " images, " << pixels << " pixels, " << RUNS
+              << " runs, renderer " << info.name << std::endl;
+
+    run("IMG_LoadTexture", renderer, [&](std::vector<SDL_Texture *> *textures){
+        for (const std::string &path: paths) {
+            textures->push_back(IMG_LoadTexture(renderer, path.c_str()));
+        }
+    });
+    run("asset pack", renderer, [&](std::vector<SDL_Texture *> *textures){
+        AssetPack pack;
+        if (not pack.open(PACK_PATH)) {
+            return;
+        }
+        for (const std::string &path: paths) {
+            const AssetPackImage *image = pack.find(path);
+            if (image == nullptr) {
+                continue;
+            }
+            /* the surface only references the mapped pixels */
+            SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(
+                const_cast<void *>(image->_pixels), image->_width, image->_height, 32,
+                image->_width * 4, SDL_PIXELFORMAT_RGBA32);
+            textures->push_back(SDL_CreateTextureFromSurface(renderer, surface));
+            SDL_FreeSurface(surface);
+        }
+    });
+
+    std::remove(PACK_PATH);
+    SDL_DestroyRenderer(renderer);
+    if (target) {
+        SDL_FreeSurface(target);
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
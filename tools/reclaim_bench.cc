@@ -0,0 +1,135 @@
+/**
+ * @file
+ * benchmark of tick latency while large panels get swapped. A panel of drawables gets replaced
+ * every few ticks, once with removed panels getting deleted right away and once with the reclaimer
+ * of the interface model deleting them in the background.
+ *
+ * usage: reclaim_bench [drawables per panel] [swaps]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL_ttf.h>
+
+#include <gui/primitives/rect.h>
+#include <gui/primitives/text.h>
+#include <models/interface_model.h>
+
+using namespace SDL_GUI;
+
+/** number of ticks between two swaps */
+static const int TICKS_PER_SWAP = 5;
+
+/**
+ * create a panel of drawables. Every 16th drawable is a text that owns a surface.
+ * @param font font of texts
+ * @param drawables number of drawables in panel
+ * @return panel
+ */
+static Drawable *create_panel(TTF_Font *font, int drawables) {
+    Rect *panel = new Rect({0, 0}, 800, 600);
+    Drawable *row = nullptr;
+    for (int i = 0; i < drawables; ++i) {
+        if (i % 32 == 0) {
+            row = new Rect({0, i / 32}, 800, 1);
+            panel->add_child(row);
+        }
+        if (i % 16 == 0) {
+            row->add_child(new Text(font, std::to_string(i), {i % 32 * 20, 0}));
+        } else {
+            row->add_child(new Rect({i % 32 * 20, 0}, 20, 1));
+        }
+    }
+    return panel;
+}
+
+/**
+ * swap panels of the tree of an interface model and print the tick latencies
+ * @param label description of run
+ * @param interface_model interface model whose tree gets changed
+ * @param font font of texts
+ * @param drawables number of drawables per panel
+ * @param swaps number of swaps
+ */
+static void measure(const std::string &label, InterfaceModel *interface_model, TTF_Font *font,
+                    int drawables, int swaps) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> swap_ticks;
+    std::vector<double> other_ticks;
+
+    Drawable *root = interface_model->drawable_root();
+    root->add_child(create_panel(font, drawables));
+    for (int tick = 0; tick < swaps * TICKS_PER_SWAP; ++tick) {
+        bool is_swap = tick % TICKS_PER_SWAP == 0;
+        /* the next panel gets built and attached to the model before the tick, only replacing it
+         * is measured */
+        Drawable *panel = nullptr;
+        if (is_swap) {
+            panel = create_panel(font, drawables);
+            panel->set_interface_model(interface_model);
+        }
+
+        clock::time_point begin = clock::now();
+        if (is_swap) {
+            root->remove_all_children();
+            root->add_child(panel);
+        }
+        root->map([](Drawable *d){
+            d->recalculate();
+        });
+        interface_model->layer_cache()->collect();
+        std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+        (is_swap ? swap_ticks : other_ticks).push_back(milliseconds.count());
+    }
+    interface_model->wait_for_reclaimer();
+    root->remove_all_children();
+    interface_model->wait_for_reclaimer();
+
+    auto average = [](const std::vector<double> &v){
+        double sum = 0;
+        for (double d: v) {
+            sum += d;
+        }
+        return v.empty() ? 0 : sum / v.size();
+    };
+    std::cout << std::left << std::setw(12) << label << std::right << std::fixed
+              << std::setprecision(2)
+              << "swap tick " << std::setw(8) << average(swap_ticks) << " ms avg "
+              << std::setw(8) << *std::max_element(swap_ticks.begin(), swap_ticks.end())
+              << " ms max, other ticks " << std::setw(8) << average(other_ticks) << " ms avg"
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int drawables = argc > 1 ? std::atoi(argv[1]) : 50000;
+    int swaps = std::max(1, argc > 2 ? std::atoi(argv[2]) : 10);
+
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    TTF_Font *font = InterfaceModel::open_default_font();
+    if (font == nullptr) {
+        std::cerr << "unable to open font: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << drawables << " drawables per panel, " << swaps << " swaps" << std::endl;
+
+    InterfaceModel *interface_model = new InterfaceModel(nullptr, 800, 600, font);
+    interface_model->set_drawable_root(new Rect({0, 0}, 800, 600));
+    interface_model->set_background_reclaim(false);
+    measure("immediate", interface_model, font, drawables, swaps);
+    interface_model->set_background_reclaim(true);
+    measure("reclaimer", interface_model, font, drawables, swaps);
+    delete interface_model;
+
+    TTF_CloseFont(font);
+    TTF_Quit();
+    return EXIT_SUCCESS;
+}
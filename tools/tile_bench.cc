@@ -0,0 +1,174 @@
+/**
+ * @file
+ * correctness check and scaling benchmark of tiled rendering. A template gets rendered directly
+ * with a single software renderer once. Then it gets rendered in tiles with 1, 2, 4, 8 and 16
+ * threads, and every tiled frame gets compared with the direct one. Frame times of all variants
+ * get printed.
+ *
+ * usage: tile_bench [-w width] [-h height] [-f frames] [-t tolerance] <template>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <gui/blend.h>
+#include <gui/drawable_tree_builder.h>
+#include <gui/frame_diff.h>
+#include <gui/texture_cache.h>
+#include <gui/tiled_renderer.h>
+#include <models/interface_model.h>
+#include <util/xml_parser.h>
+#include <views/interface_view.h>
+
+using namespace SDL_GUI;
+
+/** maximum number of frames to wait for textures to finish loading */
+static const unsigned MAX_LOADING_FRAMES = 1000;
+
+/** numbers of threads to render tiles with */
+static const unsigned THREAD_COUNTS[] = {1, 2, 4, 8, 16};
+
+/**
+ * update the drawable tree and render a single frame
+ * @param interface_model model holding the tree
+ * @param interface_view view to render with
+ */
+static void render_frame(InterfaceModel *interface_model, InterfaceView *interface_view) {
+    interface_model->drawable_root()->map([](Drawable *drawable) {
+            drawable->recalculate();
+        });
+    interface_model->drawable_root()->map([](Drawable *drawable) {
+            drawable->update();
+        });
+    interface_model->drawable_root()->update_layout();
+    interface_view->render();
+}
+
+/**
+ * render frames until all images got loaded, then time a number of frames
+ * @param interface_model model holding the tree
+ * @param interface_view view to render with
+ * @param is_loading function that checks whether images are still loading
+ * @param frames number of frames to time
+ * @return mean frame time in milliseconds
+ */
+template <typename F>
+static double run(InterfaceModel *interface_model, InterfaceView *interface_view, F is_loading,
+                  int frames) {
+    unsigned loading_frames = 0;
+    do {
+        if (loading_frames > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        render_frame(interface_model, interface_view);
+    } while (is_loading() and ++loading_frames < MAX_LOADING_FRAMES);
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point begin = clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        render_frame(interface_model, interface_view);
+    }
+    std::chrono::duration<double, std::milli> milliseconds = clock::now() - begin;
+    return milliseconds.count() / frames;
+}
+
+int main(int argc, char *argv[]) {
+    int width = 1920;
+    int height = 1080;
+    int frames = 50;
+    unsigned tolerance = 0;
+    int i = 1;
+    for (; i + 1 < argc and argv[i][0] == '-'; i += 2) {
+        std::string option = argv[i];
+        int value = std::atoi(argv[i + 1]);
+        if (option == "-w") {
+            width = std::max(1, value);
+        } else if (option == "-h") {
+            height = std::max(1, value);
+        } else if (option == "-f") {
+            frames = std::max(1, value);
+        } else if (option == "-t") {
+            tolerance = std::max(0, value);
+        } else {
+            break;
+        }
+    }
+    if (argc - i != 1) {
+        std::cerr << "usage: " << argv[0]
+                  << " [-w width] [-h height] [-f frames] [-t tolerance] <template>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string template_path = argv[i];
+
+    if (0 != TTF_Init()) {
+        std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    TTF_Font *font = InterfaceModel::open_default_font();
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                          SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (renderer == nullptr or font == nullptr) {
+        std::cerr << "unable to create renderer: " << SDL_GetError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    blend::register_target(renderer, surface);
+
+    InterfaceModel *interface_model = new InterfaceModel(renderer, width, height, font);
+    DrawableTreeBuilder builder(interface_model->font());
+    XmlParser<DrawableTreeBuilder, Drawable> parser(&builder);
+    interface_model->set_drawable_root(parser.parse_file(template_path));
+    InterfaceView *interface_view = new InterfaceView(renderer, interface_model);
+
+    TextureCache *texture_cache = TextureCache::of(renderer);
+    double direct_time = run(interface_model, interface_view, [texture_cache](){
+            return texture_cache->is_loading();
+        }, frames);
+    SDL_Surface *expected = SDL_DuplicateSurface(surface);
+    std::cout << width << "x" << height << ", " << frames << " frames" << std::endl
+              << std::left << std::setw(10) << "direct" << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << direct_time << " ms" << std::endl;
+
+    bool success = true;
+    for (unsigned thread_count: THREAD_COUNTS) {
+        TiledRenderer *tiled_renderer = new TiledRenderer(surface, thread_count);
+        interface_view->set_tiled_renderer(tiled_renderer);
+        double tiled_time = run(interface_model, interface_view, [tiled_renderer](){
+                return tiled_renderer->is_loading();
+            }, frames);
+        FrameDiff diff = compare_frames(expected, surface, tolerance);
+        success = success and diff.equal();
+        std::cout << std::left << std::setw(10) << (std::to_string(thread_count) + " threads")
+                  << std::right << std::setw(10) << tiled_time << " ms"
+                  << std::setw(8) << direct_time / tiled_time << "x  ";
+        if (diff.equal()) {
+            std::cout << "identical" << std::endl;
+        } else {
+            std::cout << diff._differing_pixels << " pixels differ by up to "
+                      << diff._max_difference << " in " << diff._bounds.w << "x"
+                      << diff._bounds.h << "+" << diff._bounds.x << "+" << diff._bounds.y
+                      << std::endl;
+        }
+        interface_view->set_tiled_renderer(nullptr);
+    }
+
+    delete interface_view;
+    delete interface_model;
+    SDL_FreeSurface(expected);
+    TextureCache::destroy(renderer);
+    blend::unregister_target(renderer);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    TTF_CloseFont(font);
+    TTF_Quit();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}